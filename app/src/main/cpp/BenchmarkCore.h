@@ -6,6 +6,9 @@
 #define PERFORMIC_BENCHMARKCORE_H
 
 #include <string>
+#include <functional>
+#include <memory>
+#include "PowerSampler.h"
 
 class BenchmarkCore {
 public:
@@ -13,9 +16,32 @@ public:
     // It will return a string formatted as JSON.
     std::string runFullBenchmark();
 
+    // Runs only the registered kernels matching filter (comma separated
+    // names, suites or tags, see BenchmarkRegistry::select). Same JSON shape;
+    // fields of kernels that did not run are absent.
+    // preset: "quick", "standard" or "extended" (see BenchmarkSizes).
+    std::string runBenchmarks(const std::string& filter, const std::string& preset = "standard");
+
+    // JSON array describing every registered kernel, with the working set
+    // each one would use at the given preset.
+    std::string listBenchmarks(const std::string& preset = "standard");
+
+    // Runs a benchmark driven from outside the registry (the GPU scene needs
+    // a window from Java) inside the same idle baseline and energy window as
+    // the kernels. run() returns the score. JSON: success, name, score, energy.
+    std::string runMeasured(const std::string& name, const std::function<double()>& run);
+
+    // Power readings for the next run when /sys/class/power_supply is not
+    // readable, e.g. BatteryManager through JNI.
+    void setFallbackPowerSource(std::unique_ptr<PowerSource> source);
+
 private:
     // Our new thermal check gatekeeper.
     bool isDeviceCoolEnough();
+
+    // sysfs battery if readable, otherwise the fallback (if any).
+    std::unique_ptr<PowerSource> openPowerSource();
+    std::unique_ptr<PowerSource> fallbackPowerSource;
 };
 
 #endif //PERFORMIC_BENCHMARKCORE_H
\ No newline at end of file
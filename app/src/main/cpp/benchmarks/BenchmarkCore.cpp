@@ -6,8 +6,13 @@
 #include <string>
 #include <vector>     // <--- Added for std::vector
 #include <sstream>    // <--- REQUIRED for stringstream
-#include "cpu_benchmark/CpuBenchmark.h"
-#include "memoty_benchmark/MemoryBenchmark.h"
+#include <cstdlib>
+#include <memory>
+#include <chrono>
+#include "BenchmarkRegistry.h"
+#include "BenchmarkSizes.h"
+#include "PowerSampler.h"
+#include "utils.h"
 
 #define LOG_TAG "PerformicCore"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
@@ -22,52 +27,182 @@ enum {
     ATHERMAL_STATUS_LIGHT = 1,
 };
 
-// --- HELPER FUNCTION ---
-// Converts a C++ vector<double> into a JSON string "[1.0, 2.0, 3.0]"
-// This is now strictly internal to this file.
-static std::string vectorToJsonArray(const std::vector<double>& vec) {
+// --- ENERGY CONFIGURATION ---
+constexpr int IDLE_BASELINE_MS = 2000;
+// Overrides the power_supply root, e.g. a fake sysfs tree on a Linux host.
+constexpr const char* POWER_SUPPLY_ROOT_ENV = "PERFORMIC_POWER_SUPPLY_ROOT";
+
+// One subtest's energy window.
+static std::string energyResultToJson(const PowerSampler::EnergyResult& w) {
     std::stringstream ss;
-    ss << "[";
-    for (size_t i = 0; i < vec.size(); ++i) {
-        ss << vec[i];
-        if (i < vec.size() - 1) {
-            ss << ",";
-        }
+    ss << "{";
+    ss << "\"name\":\"" << w.name << "\", ";
+    ss << "\"seconds\":" << w.seconds << ", ";
+    ss << "\"joules\":" << w.joules << ", ";
+    ss << "\"netJoules\":" << w.netJoules << ", ";
+    ss << "\"averageWatts\":" << w.averageWatts << ", ";
+    ss << "\"netAverageWatts\":" << w.netAverageWatts << ", ";
+    ss << "\"iterations\":" << w.iterations << ", ";
+    if (w.iterations > 0) {
+        ss << "\"joulesPerIteration\":" << w.joulesPerIteration << ", ";
+    }
+    ss << "\"score\":" << w.score << ", ";
+    ss << "\"scorePerWatt\":" << w.scorePerWatt;
+    ss << "}";
+    return ss.str();
+}
+
+// Quotes a caller-supplied string for embedding in the JSON.
+static std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c >= 0x20) out += c;
+    }
+    return out + "\"";
+}
+
+// Battery power integrated per subtest, idle baseline subtracted.
+static std::string energyToJson(const PowerSampler& power) {
+    std::stringstream ss;
+    ss << "{";
+    ss << "\"available\":" << (power.available() ? "true" : "false") << ", ";
+    ss << "\"source\":" << jsonString(power.sourceName()) << ", ";
+    ss << "\"charging\":" << (power.charging() ? "true" : "false") << ", ";
+    ss << "\"idleWatts\":" << power.idleWatts() << ", ";
+    ss << "\"subtests\":" << jsonArray(power.results(), energyResultToJson);
+    ss << "}";
+    return ss.str();
+}
+
+// Idle baseline first, before anything heats up.
+static void startPowerSampling(PowerSampler& power) {
+    if (power.available()) {
+        power.measureIdleBaseline(IDLE_BASELINE_MS);
+        LOGI("BenchmarkCore: Power source %s, idle %.3f W%s", power.sourceName().c_str(),
+             power.idleWatts(), power.charging() ? " (charging)" : "");
+    } else {
+        LOGI("BenchmarkCore: No battery power readings, energy report disabled.");
     }
-    ss << "]";
+}
+
+// The problem sizes of this run and the hardware they were derived from.
+static std::string sizesToJson(const BenchmarkSizes& s) {
+    std::stringstream ss;
+    ss << "{";
+    ss << "\"preset\":\"" << BenchmarkSizes::presetName(s.preset) << "\", ";
+    ss << "\"cachesDetected\":" << (s.cachesDetected ? "true" : "false") << ", ";
+    ss << "\"l1dBytes\":" << s.l1dBytes << ", ";
+    ss << "\"l2Bytes\":" << s.l2Bytes << ", ";
+    ss << "\"llcBytes\":" << s.llcBytes << ", ";
+    ss << "\"ramBytes\":" << s.ramBytes << ", ";
+    ss << "\"cores\":" << s.cores << ", ";
+    ss << "\"stabilityIterations\":" << s.stabilityIterations << ", ";
+    ss << "\"matrixSize\":" << s.matrixSize << ", ";
+    ss << "\"luMatrixSize\":" << s.luMatrixSize << ", ";
+    ss << "\"intArraySize\":" << s.intArraySize << ", ";
+    ss << "\"compressionSize\":" << s.compressionSize << ", ";
+    ss << "\"mandelbrotSize\":" << s.mandelbrotSize << ", ";
+    ss << "\"mandelbrotIter\":" << s.mandelbrotIter << ", ";
+    ss << "\"memL1Bytes\":" << s.memL1Bytes << ", ";
+    ss << "\"memL2Bytes\":" << s.memL2Bytes << ", ";
+    ss << "\"memRamBytes\":" << s.memRamBytes << ", ";
+    ss << "\"peakIterations\":" << s.peakIterations << ", ";
+    ss << "\"sortKeys\":" << s.sortKeys << ", ";
+    ss << "\"hashKeys\":" << s.hashKeys << ", ";
+    ss << "\"gemmSize\":" << s.gemmSize << ", ";
+    ss << "\"cryptoSmallBytes\":" << s.cryptoSmallBytes << ", ";
+    ss << "\"cryptoLargeBytes\":" << s.cryptoLargeBytes;
+    ss << "}";
+    return ss.str();
+}
+
+// Registry metadata of one kernel plus the outcome of its run.
+static std::string kernelEntryToJson(const KernelInfo& info, const BenchmarkKernel& kernel,
+                                     bool verified, double seconds) {
+    std::stringstream ss;
+    ss << "{";
+    ss << "\"name\":\"" << info.name << "\", ";
+    ss << "\"suite\":\"" << info.suite << "\", ";
+    ss << "\"tags\":" << jsonArray(info.tags, jsonString) << ", ";
+    ss << "\"threads\":" << info.threads << ", ";
+    ss << "\"workingSetBytes\":" << kernel.workingSetBytes() << ", ";
+    ss << "\"referenceScore\":" << info.referenceScore << ", ";
+    ss << "\"score\":" << kernel.score() << ", ";
+    ss << "\"relativeScore\":" << (info.referenceScore > 0.0 ? kernel.score() / info.referenceScore : 0.0) << ", ";
+    ss << "\"verified\":" << (verified ? "true" : "false") << ", ";
+    ss << "\"seconds\":" << seconds;
+    ss << "}";
     return ss.str();
 }
 
 std::string BenchmarkCore::runFullBenchmark() {
-    LOGI("BenchmarkCore: Starting full benchmark.");
+    return runBenchmarks("");
+}
+
+std::string BenchmarkCore::runBenchmarks(const std::string& filter, const std::string& preset) {
+    BenchmarkSizes::Preset sizePreset;
+    if (!BenchmarkSizes::parsePreset(preset, sizePreset)) {
+        return "{\"success\":false, \"message\":" + jsonString("Unknown preset '" + preset + "'") + "}";
+    }
+    BenchmarkSizes sizes = BenchmarkSizes::derive(sizePreset);
+
+    std::vector<const KernelInfo*> selected = BenchmarkRegistry::instance().select(filter);
+    if (selected.empty()) {
+        LOGI("BenchmarkCore: Nothing matches '%s'.", filter.c_str());
+        return "{\"success\":false, \"message\":" + jsonString("No benchmark matches '" + filter + "'") + "}";
+    }
+    LOGI("BenchmarkCore: Running %zu kernel(s) for '%s', %s sizes (L2 %zu KB, LLC %zu KB).",
+         selected.size(), filter.c_str(), BenchmarkSizes::presetName(sizePreset),
+         sizes.l2Bytes / 1024, sizes.llcBytes / 1024);
+
+    // 0. Power sampling (idle baseline first, before anything heats up)
+    PowerSampler power(openPowerSource());
+    startPowerSampling(power);
+
+    // 1. Run the selected kernels, one at a time, in registry order
+    std::stringstream fields;   // kernel result fields, top level
+    std::stringstream entries;  // "kernels" array
+    bool allVerified = true;
 
-    // 1. Run CPU Suite (Returns Scores + History Vectors)
-    CpuBenchmark cpu_test;
-    CpuBenchmark::Scores results = cpu_test.runFullSuite();
+    for (size_t i = 0; i < selected.size(); ++i) {
+        const KernelInfo& info = *selected[i];
+        std::unique_ptr<BenchmarkKernel> kernel = info.create();
 
-    // 2. Run Memory Suite
-    MemoryBenchmark mem_test;
-    MemoryBenchmark::MemoryScores memResults = mem_test.runMemorySuite();
+        kernel->setup(sizes);
+        power.beginWindow(info.name);
+        auto start = std::chrono::steady_clock::now();
+        kernel->run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        power.endWindow(kernel->score(), kernel->iterations());
+        bool verified = kernel->verify();
+        kernel->teardown();
 
-    // 3. Build JSON
+        if (!verified) allVerified = false;
+        LOGI("BenchmarkCore: %s score %.2f in %.2f s%s", info.name.c_str(), kernel->score(), seconds,
+             verified ? "" : " (verification FAILED)");
+
+        kernel->writeJson(fields);
+        fields << ", ";
+        entries << kernelEntryToJson(info, *kernel, verified, seconds);
+        if (i < selected.size() - 1) {
+            entries << ",";
+        }
+    }
+
+    // 2. Build JSON
     std::stringstream ss;
     ss << "{";
     ss << "\"success\":true, ";
-    ss << "\"message\":\"Benchmark complete!\", ";
+    ss << "\"message\":\"" << (allVerified ? "Benchmark complete!" : "Benchmark complete, verification failed!") << "\", ";
+    ss << "\"selection\":" << jsonString(filter) << ", ";
+    ss << "\"sizes\":" << sizesToJson(sizes) << ", ";
 
-    // Scores
-    ss << "\"singleCore\":" << results.singleCoreScore << ", ";
-    ss << "\"multiCore\":" << results.multiCoreScore << ", ";
+    ss << fields.str();
 
-    // RAM
-    ss << "\"ramScore\":" << memResults.memoryScore << ", ";
-    ss << "\"ramGBs\":" << memResults.ramThroughput << ", ";
-    ss << "\"l1GBs\":"    << memResults.l1Throughput << ", ";
-    ss << "\"l2GBs\":"    << memResults.l2Throughput << ", ";
+    ss << "\"energy\":" << energyToJson(power) << ", ";
 
-    // --- NEW: Inject the History Arrays ---
-    ss << "\"singleCoreHistory\":" << vectorToJsonArray(results.singleCoreHistory) << ", ";
-    ss << "\"multiCoreHistory\":" << vectorToJsonArray(results.multiCoreHistory);
+    ss << "\"kernels\":[" << entries.str() << "]";
 
     ss << "}";
 
@@ -76,3 +211,57 @@ std::string BenchmarkCore::runFullBenchmark() {
 
     return json_result;
 }
+
+std::string BenchmarkCore::runMeasured(const std::string& name, const std::function<double()>& run) {
+    PowerSampler power(openPowerSource());
+    startPowerSampling(power);
+
+    power.beginWindow(name);
+    double score = run();
+    power.endWindow(score, 0); // no common unit of work across frames
+    LOGI("BenchmarkCore: %s score %.2f", name.c_str(), score);
+
+    std::stringstream ss;
+    ss << "{";
+    ss << "\"success\":true, ";
+    ss << "\"name\":" << jsonString(name) << ", ";
+    ss << "\"score\":" << score << ", ";
+    ss << "\"energy\":" << energyToJson(power);
+    ss << "}";
+    return ss.str();
+}
+
+void BenchmarkCore::setFallbackPowerSource(std::unique_ptr<PowerSource> source) {
+    fallbackPowerSource = std::move(source);
+}
+
+std::unique_ptr<PowerSource> BenchmarkCore::openPowerSource() {
+    const char* powerRoot = getenv(POWER_SUPPLY_ROOT_ENV);
+    std::unique_ptr<PowerSource> sysfs(new SysfsPowerSource(powerRoot ? powerRoot : SysfsPowerSource::DEFAULT_ROOT));
+    double watts = 0.0;
+    if (sysfs->readWatts(watts) || !fallbackPowerSource) return sysfs;
+    LOGI("BenchmarkCore: power_supply not readable, using %s", fallbackPowerSource->describe().c_str());
+    return std::move(fallbackPowerSource);
+}
+
+std::string BenchmarkCore::listBenchmarks(const std::string& preset) {
+    BenchmarkSizes::Preset sizePreset;
+    if (!BenchmarkSizes::parsePreset(preset, sizePreset)) {
+        return "{\"success\":false, \"message\":" + jsonString("Unknown preset '" + preset + "'") + "}";
+    }
+    BenchmarkSizes sizes = BenchmarkSizes::derive(sizePreset);
+
+    std::vector<const KernelInfo*> all = BenchmarkRegistry::instance().select("");
+    return jsonArray(all, [&sizes](const KernelInfo* info) {
+        std::stringstream ss;
+        ss << "{";
+        ss << "\"name\":\"" << info->name << "\", ";
+        ss << "\"suite\":\"" << info->suite << "\", ";
+        ss << "\"tags\":" << jsonArray(info->tags, jsonString) << ", ";
+        ss << "\"threads\":" << info->threads << ", ";
+        ss << "\"workingSetBytes\":" << info->workingSetHint(sizes) << ", ";
+        ss << "\"referenceScore\":" << info->referenceScore;
+        ss << "}";
+        return ss.str();
+    });
+}
@@ -0,0 +1,44 @@
+#include "BenchmarkRegistry.h"
+#include <algorithm>
+#include <sstream>
+
+BenchmarkRegistry& BenchmarkRegistry::instance() {
+    // Function-local so registrations from any translation unit's static
+    // initialisers find it constructed.
+    static BenchmarkRegistry registry;
+    return registry;
+}
+
+void BenchmarkRegistry::add(KernelInfo info) {
+    entries.push_back(std::move(info));
+}
+
+static bool matches(const KernelInfo& info, const std::string& token) {
+    if (token == "all" || token == info.name || token == info.suite) return true;
+    return std::find(info.tags.begin(), info.tags.end(), token) != info.tags.end();
+}
+
+std::vector<const KernelInfo*> BenchmarkRegistry::select(const std::string& filter) const {
+    std::vector<std::string> tokens;
+    std::stringstream ss(filter);
+    std::string token;
+    while (std::getline(ss, token, ',')) {
+        token.erase(0, token.find_first_not_of(" \t"));
+        token.erase(token.find_last_not_of(" \t") + 1);
+        if (!token.empty()) tokens.push_back(token);
+    }
+
+    std::vector<const KernelInfo*> selected;
+    for (const KernelInfo& info : entries) {
+        bool wanted = tokens.empty();
+        for (const std::string& t : tokens) {
+            if (matches(info, t)) { wanted = true; break; }
+        }
+        if (wanted) selected.push_back(&info);
+    }
+
+    // Registration order depends on link order; run order must not.
+    std::stable_sort(selected.begin(), selected.end(),
+                     [](const KernelInfo* a, const KernelInfo* b) { return a->order < b->order; });
+    return selected;
+}
@@ -0,0 +1,92 @@
+//
+// Created by Marius on 18/10/2026.
+//
+
+#ifndef PERFORMIC_BENCHMARKREGISTRY_H
+#define PERFORMIC_BENCHMARKREGISTRY_H
+
+#include <stddef.h>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "BenchmarkSizes.h"
+
+// One registered unit of work. BenchmarkCore drives every kernel through
+// setup -> run -> verify -> teardown, strictly one kernel at a time, so a
+// kernel that uses all cores never competes with another one.
+class BenchmarkKernel {
+public:
+    virtual ~BenchmarkKernel() {}
+
+    // Allocates for the problem sizes of this run.
+    virtual void setup(const BenchmarkSizes& sizes) = 0;
+    virtual void run() = 0;
+    virtual bool verify() { return true; }
+    virtual void teardown() {}
+
+    // Headline number of the last run, in the unit of referenceScore.
+    virtual double score() const = 0;
+    // Repetitions inside run(), used for energy per iteration. 0 when run()
+    // has no single unit of work; the report then omits joulesPerIteration.
+    virtual int iterations() const { return 1; }
+    // Largest resident footprint of run(), valid after setup(). Each kernel
+    // also provides static size_t workingSetHint(const BenchmarkSizes&), the
+    // same figure without allocating, for listings.
+    virtual size_t workingSetBytes() const = 0;
+
+    // Writes the kernel's result fields as "key":value pairs separated by
+    // ", " (no trailing separator). They land at the top level of the report.
+    virtual void writeJson(std::ostream& out) const = 0;
+};
+
+struct KernelInfo {
+    std::string name;               // unique, e.g. "cpu_single"
+    std::string suite;              // e.g. "cpu"
+    std::vector<std::string> tags;  // free-form selectors, e.g. "multi_core"
+    unsigned threads;               // threads used by run(); 0 = all cores
+    double referenceScore;          // score() on the reference device; 0 = none yet
+    int order;                      // position in a full run, ascending
+    std::function<std::unique_ptr<BenchmarkKernel>()> create;
+    std::function<size_t(const BenchmarkSizes&)> workingSetHint;  // workingSetBytes() at given sizes, no setup()
+};
+
+class BenchmarkRegistry {
+public:
+    static BenchmarkRegistry& instance();
+
+    void add(KernelInfo info);
+
+    // filter is a comma separated list matched against name, suite and tags.
+    // Empty or "all" selects everything. Result is in run order.
+    std::vector<const KernelInfo*> select(const std::string& filter) const;
+
+    const std::vector<KernelInfo>& kernels() const { return entries; }
+
+private:
+    std::vector<KernelInfo> entries;
+};
+
+// Declare one at namespace scope next to the kernel to register it:
+//   static KernelRegistration<MemoryKernel> registration("memory", "memory", {"bandwidth"}, 1, 1000.0, 20);
+template<typename Kernel>
+class KernelRegistration {
+public:
+    KernelRegistration(const char* name, const char* suite, std::initializer_list<const char*> tags,
+                       unsigned threads, double referenceScore, int order) {
+        KernelInfo info;
+        info.name = name;
+        info.suite = suite;
+        for (const char* tag : tags) info.tags.push_back(tag);
+        info.threads = threads;
+        info.referenceScore = referenceScore;
+        info.order = order;
+        info.create = []() { return std::unique_ptr<BenchmarkKernel>(new Kernel()); };
+        info.workingSetHint = &Kernel::workingSetHint;
+        BenchmarkRegistry::instance().add(std::move(info));
+    }
+};
+
+#endif //PERFORMIC_BENCHMARKREGISTRY_H
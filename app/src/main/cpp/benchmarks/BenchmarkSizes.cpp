@@ -0,0 +1,120 @@
+#include "BenchmarkSizes.h"
+#include "CpuInfo.h"
+#include "cpu_benchmark/CpuBenchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// --- CONFIGURATION ---
+constexpr size_t MB = 1024 * 1024;
+constexpr size_t UNKNOWN_RAM_BYTES = 2048 * MB; // assumed when sysconf fails
+constexpr int RAM_FRACTION = 8;                  // no kernel allocates more than RAM / 8
+constexpr size_t QUICK_RAM_BYTES = 64 * MB;      // quick RAM buffer, whatever the LLC size
+
+// Side of a square matrix taking bytesPerCell per (i, j) that fits in
+// targetBytes, rounded down to a multiple of `multiple` and clamped.
+static int squareSide(size_t targetBytes, size_t bytesPerCell, int multiple, int minSide, int maxSide) {
+    int side = (int)std::sqrt((double)targetBytes / (double)bytesPerCell);
+    side = side / multiple * multiple;
+    return std::max(minSide, std::min(side, maxSide));
+}
+
+static size_t clampBytes(size_t value, size_t lo, size_t hi) {
+    return std::max(lo, std::min(value, std::max(lo, hi)));
+}
+
+static int nextPowerOfTwo(size_t value) {
+    size_t p = 1;
+    while (p < value) p <<= 1;
+    return (int)p;
+}
+
+BenchmarkSizes BenchmarkSizes::derive(Preset preset) {
+    const CpuInfo::Caches& caches = CpuInfo::caches();
+
+    BenchmarkSizes s;
+    s.preset = preset;
+    s.l1dBytes = caches.l1dBytes;
+    s.l2Bytes = caches.l2Bytes;
+    s.llcBytes = caches.llcBytes;
+    s.ramBytes = CpuInfo::totalRamBytes();
+    s.cores = CpuInfo::coreCount();
+    s.cachesDetected = caches.detected;
+
+    const size_t ramBudget = (s.ramBytes ? s.ramBytes : UNKNOWN_RAM_BYTES) / RAM_FRACTION;
+    const bool quick = preset == QUICK;
+    const bool extended = preset == EXTENDED;
+
+    // ---- CpuBenchmark ----
+    // Scored tests stay at the calibration sizes so the score means the
+    // same thing on every device and preset; the preset only sets how often
+    // they run.
+    s.stabilityIterations = quick ? 1 : (extended ? 30 : 15);
+    s.warmupIterations = quick ? 0 : 5;
+    s.matrixSize = CpuBenchmark::REF_MATRIX_SIZE;
+    s.luMatrixSize = CpuBenchmark::REF_LU_MATRIX_SIZE;
+    s.intArraySize = CpuBenchmark::REF_INT_ARRAY_SIZE;
+    s.compressionSize = CpuBenchmark::REF_COMPRESSION_SIZE;
+    s.mandelbrotSize = CpuBenchmark::REF_MANDELBROT_SIZE;
+    s.mandelbrotIter = CpuBenchmark::REF_MANDELBROT_ITER;
+
+    // ---- MemoryBenchmark ----
+    // Source + destination take half of L1 / L2; RAM buffers are far past the
+    // LLC. Quick uses a fixed buffer so it stays quick on large-LLC machines,
+    // at the cost of partly hitting the LLC there.
+    s.memL1Bytes = clampBytes(s.l1dBytes / 4, 4 * 1024, 256 * 1024);
+    s.memL2Bytes = clampBytes(s.l2Bytes / 4, 2 * s.memL1Bytes, 8 * MB);
+    size_t ramTarget = quick ? QUICK_RAM_BYTES
+                             : (extended ? std::max(16 * s.llcBytes, 256 * MB) : std::max(8 * s.llcBytes, 64 * MB));
+    s.memRamBytes = clampBytes(ramTarget, 2 * s.memL2Bytes, ramBudget / 2);
+    s.cacheBytesMoved = quick ? 0.2e9 : (extended ? 6.4e9 : 1.6e9);
+    s.ramBytesMoved = quick ? 2e9 : (extended ? 64e9 : 32e9);
+
+    // ---- FpPeakBenchmark ----
+    s.peakIterations = quick ? 2000000 : (extended ? 100000000 : 20000000);
+    s.peakRepeats = quick ? 1 : (extended ? 5 : 3);
+
+    // ---- DataStructureBenchmark ----
+    // Sort input (plus reference, copy and scratch) well past the LLC: ~2x LLC per array.
+    size_t sortKeys = quick ? 1000000 : std::max<size_t>(10000000, 2 * s.llcBytes / sizeof(uint32_t));
+    if (extended) sortKeys *= 4;
+    s.sortKeys = (int)std::min(sortKeys, ramBudget / (4 * sizeof(uint32_t)));
+    // Hash tables take ~32 bytes per key; keep them at least 8x the LLC.
+    size_t hashKeys = quick ? (1u << 18) : (size_t)nextPowerOfTwo(std::max<size_t>(1u << 21, s.llcBytes / 4));
+    if (extended) hashKeys *= 4;
+    while (hashKeys > (1u << 16) && hashKeys * 64 > ramBudget) hashKeys >>= 1;
+    s.hashKeys = (int)hashKeys;
+    s.dsRepeats = quick ? 1 : (extended ? 3 : 2);
+
+    // ---- InferenceBenchmark ----
+    // int8 A and B^T together about the size of L2.
+    int gemm = squareSide(s.l2Bytes, 2, 64, 256, 1024);
+    s.gemmSize = quick ? 256 : (extended ? std::min(2 * gemm, 1536) : gemm);
+    s.inferenceRepeats = quick ? 1 : (extended ? 10 : 5);
+
+    // ---- ImagePipelineBenchmark ----
+    s.imageRepeats = quick ? 1 : (extended ? 5 : 3);
+
+    // ---- CryptoBenchmark ----
+    s.cryptoSmallBytes = 1024;
+    s.cryptoLargeBytes = clampBytes(s.l2Bytes / 2, 64 * 1024, MB);
+    s.cryptoBytes = quick ? 64e6 : (extended ? 2e9 : 512e6);
+    s.cryptoRepeats = quick ? 1 : (extended ? 5 : 3);
+
+    return s;
+}
+
+bool BenchmarkSizes::parsePreset(const std::string& name, Preset& preset) {
+    if (name == "quick") { preset = QUICK; return true; }
+    if (name == "standard") { preset = STANDARD; return true; }
+    if (name == "extended") { preset = EXTENDED; return true; }
+    return false;
+}
+
+const char* BenchmarkSizes::presetName(Preset preset) {
+    switch (preset) {
+        case QUICK: return "quick";
+        case EXTENDED: return "extended";
+        default: return "standard";
+    }
+}
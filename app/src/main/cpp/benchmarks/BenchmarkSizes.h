@@ -0,0 +1,81 @@
+//
+// Created by Marius on 18/10/2026.
+//
+
+#ifndef PERFORMIC_BENCHMARKSIZES_H
+#define PERFORMIC_BENCHMARKSIZES_H
+
+#include <stddef.h>
+#include <string>
+
+// Problem sizes for one run, derived from the detected caches, core count
+// and RAM so each kernel lands on the memory level it is meant to stress
+// (e.g. the memory buffers sit past the LLC, the GEMM fits L2). The scored
+// CpuBenchmark tests are the exception: their sizes are always the
+// calibration sizes (CpuBenchmark::REF_*), so scores stay comparable across
+// devices and presets.
+//
+//   quick    - smoke run of a few seconds, used to gate device-image builds
+//   standard - the normal benchmark
+//   extended - larger working sets and more repetitions
+struct BenchmarkSizes {
+    enum Preset { QUICK, STANDARD, EXTENDED };
+
+    Preset preset;
+
+    // Hardware the sizes were derived from
+    size_t l1dBytes;
+    size_t l2Bytes;
+    size_t llcBytes;
+    size_t ramBytes;
+    unsigned int cores;
+    bool cachesDetected;
+
+    // CpuBenchmark. derive() sets the sizes to the calibration sizes on
+    // every device and preset; only the iteration counts follow the preset.
+    int stabilityIterations;
+    int warmupIterations;
+    int matrixSize;
+    int luMatrixSize;
+    int intArraySize;
+    int compressionSize;
+    int mandelbrotSize;
+    int mandelbrotIter;
+
+    // MemoryBenchmark (bytes per buffer; source and destination each)
+    size_t memL1Bytes;
+    size_t memL2Bytes;
+    size_t memRamBytes;
+    double cacheBytesMoved;  // per cache level
+    double ramBytesMoved;
+
+    // FpPeakBenchmark
+    long peakIterations;
+    int peakRepeats;
+
+    // DataStructureBenchmark
+    int sortKeys;
+    int hashKeys;
+    int dsRepeats;
+
+    // InferenceBenchmark
+    int gemmSize;            // multiple of 64
+    int inferenceRepeats;
+
+    // ImagePipelineBenchmark (frame size is fixed: a 12 MP camera frame)
+    int imageRepeats;
+
+    // CryptoBenchmark
+    size_t cryptoSmallBytes;  // one network packet
+    size_t cryptoLargeBytes;  // ~ half of L2
+    double cryptoBytes;       // bytes hashed / encrypted per measurement
+    int cryptoRepeats;
+
+    static BenchmarkSizes derive(Preset preset);
+
+    // "quick", "standard" or "extended"; false for anything else.
+    static bool parsePreset(const std::string& name, Preset& preset);
+    static const char* presetName(Preset preset);
+};
+
+#endif //PERFORMIC_BENCHMARKSIZES_H
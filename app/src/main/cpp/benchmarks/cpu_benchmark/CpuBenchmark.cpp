@@ -1,5 +1,6 @@
 #include "CpuBenchmark.h"
 #include "utils.h"
+#include "BenchmarkRegistry.h"
 #include <vector>
 #include <chrono>
 #include <cmath>
@@ -8,13 +9,24 @@
 #include <algorithm>
 #include <android/log.h>
 #include <numeric>
+#include <sstream>
 
 
 #define LOG_TAG "PerformicCPU"
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
 
-CpuBenchmark::Scores CpuBenchmark::runFullSuite() {
-    for (int i = 0; i < WARMUP_ITERATIONS; ++i){
+CpuBenchmark::CpuBenchmark(const BenchmarkSizes& sizes)
+        : stabilityIterations(sizes.stabilityIterations),
+          warmupIterations(sizes.warmupIterations),
+          compressionSize(sizes.compressionSize),
+          matrixSize(sizes.matrixSize),
+          intArraySize(sizes.intArraySize),
+          luMatrixSize(sizes.luMatrixSize),
+          mandelbrotSize(sizes.mandelbrotSize),
+          mandelbrotIter(sizes.mandelbrotIter) {}
+
+CpuBenchmark::Scores CpuBenchmark::runSingleCoreSuite() {
+    for (int i = 0; i < warmupIterations; ++i){
         float resF = performMatrixMultiplication(); DoNotOptimize(resF);
         long resI = performIntegerWorkload();       DoNotOptimize(resI);
         bool resL = performLUDecomposition();       DoNotOptimize(resL);
@@ -22,14 +34,14 @@ CpuBenchmark::Scores CpuBenchmark::runFullSuite() {
     }
 
     std::vector<double> singleHistory;
-    std::vector<double> multiHistory;
 
-    double refFloat = 600.0;
-    double refInt = 647.0;
-    double refLu =  955.0;
-    double refCompress = 128.0;
+    // Reference times (ms) at the REF_ sizes
+    const double refFloat = 600.0;
+    const double refInt = 647.0;
+    const double refLu = 955.0;
+    const double refCompress = 128.0;
 
-    for (int i = 0; i < STABILITY_ITERATIONS; ++i) {
+    for (int i = 0; i < stabilityIterations; ++i) {
         //float matrix mult
         auto startF = std::chrono::high_resolution_clock::now();
         ClobberMemory();
@@ -83,14 +95,19 @@ CpuBenchmark::Scores CpuBenchmark::runFullSuite() {
         avgSingleScore = sum / singleHistory.size();
     }
 
+    return {avgSingleScore, singleHistory};
+}
 
+CpuBenchmark::Scores CpuBenchmark::runMultiCoreSuite() {
+    std::vector<double> multiHistory;
 
     unsigned int numCores = std::thread::hardware_concurrency();
     if (numCores == 0) numCores = 4;
 
-    double refMulti = 14395.0;
+    // Reference time (ms) at the REF_ sizes
+    const double refMulti = 14395.0;
 
-    for (int iter = 0; iter < STABILITY_ITERATIONS; ++iter) {
+    for (int iter = 0; iter < stabilityIterations; ++iter) {
         std::vector<double> subIterations;
 
         for (int sub = 0; sub < 5; ++sub) {
@@ -122,7 +139,18 @@ CpuBenchmark::Scores CpuBenchmark::runFullSuite() {
         avgMultiScore = sum / multiHistory.size();
     }
 
-    return {avgSingleScore, avgMultiScore, singleHistory, multiHistory};
+    return {avgMultiScore, multiHistory};
+}
+
+size_t CpuBenchmark::singleCoreWorkingSetBytes() const {
+    size_t matrix = 3 * (size_t)matrixSize * matrixSize * sizeof(float);
+    size_t lu = (size_t)luMatrixSize * luMatrixSize * sizeof(double);
+    size_t compression = 3 * (size_t)compressionSize;
+    return std::max(matrix, std::max(lu, compression));
+}
+
+size_t CpuBenchmark::multiCoreWorkingSetBytes() const {
+    return 0; // Mandelbrot is register-resident
 }
 
 
@@ -133,7 +161,7 @@ void CpuBenchmark::runThreadedWorkload() {
 }
 
 float CpuBenchmark::performMatrixMultiplication() {
-    int size = MATRIX_SIZE;
+    int size = matrixSize;
     std::vector<float> a(size * size);
     std::vector<float> b(size * size);
     std::vector<float> result(size * size, 0.0f);
@@ -166,7 +194,7 @@ long CpuBenchmark::performIntegerWorkload() {
     uint32_t hash = 0xDEADBEEF;
     uint32_t seed = 0x12345678;
 
-    for (int i = 0; i < INT_ARRAY_SIZE; ++i) {
+    for (int i = 0; i < intArraySize; ++i) {
         seed = mixBits(i, seed, hash);
         hash = seed ^ i;
     }
@@ -174,7 +202,7 @@ long CpuBenchmark::performIntegerWorkload() {
 }
 
 bool CpuBenchmark::performLUDecomposition() {
-    int n = LU_MATRIX_SIZE;
+    int n = luMatrixSize;
     std::vector<double> A(n * n);
 
     for (int i = 0; i < n; i++) {
@@ -216,7 +244,7 @@ bool CpuBenchmark::performLUDecomposition() {
 }
 
 double CpuBenchmark::performDataCompression() {
-    int n = COMPRESSION_SIZE;
+    int n = compressionSize;
     std::vector<uint8_t> input(n);
     std::vector<uint8_t> output(n * 2);
 
@@ -238,9 +266,9 @@ double CpuBenchmark::performDataCompression() {
 }
 
 double CpuBenchmark::performMandelbrot() {
-    const int WIDTH = MANDELBROT_SIZE;
-    const int HEIGHT = MANDELBROT_SIZE;
-    const int MAX_ITER = MANDELBROT_ITER;
+    const int WIDTH = mandelbrotSize;
+    const int HEIGHT = mandelbrotSize;
+    const int MAX_ITER = mandelbrotIter;
 
     double sum = 0.0;
 
@@ -261,4 +289,76 @@ double CpuBenchmark::performMandelbrot() {
         }
     }
     return sum;
-}
\ No newline at end of file
+}
+
+// =========================================================
+// REGISTRATION
+// =========================================================
+
+// Converts a C++ vector<double> into a JSON string "[1.0, 2.0, 3.0]"
+static std::string vectorToJsonArray(const std::vector<double>& vec) {
+    std::stringstream ss;
+    ss << "[";
+    for (size_t i = 0; i < vec.size(); ++i) {
+        ss << vec[i];
+        if (i < vec.size() - 1) {
+            ss << ",";
+        }
+    }
+    ss << "]";
+    return ss.str();
+}
+
+class CpuSingleCoreKernel : public BenchmarkKernel {
+public:
+    void setup(const BenchmarkSizes& sizes) override {
+        cpu.reset(new CpuBenchmark(sizes));
+        workingSet = cpu->singleCoreWorkingSetBytes();
+    }
+    void run() override { scores = cpu->runSingleCoreSuite(); }
+    bool verify() override { return scores.score > 0.0; }
+    void teardown() override { cpu.reset(); }
+    double score() const override { return scores.score; }
+    int iterations() const override { return (int)scores.history.size(); }
+    size_t workingSetBytes() const override { return workingSet; }
+    static size_t workingSetHint(const BenchmarkSizes& sizes) { return CpuBenchmark(sizes).singleCoreWorkingSetBytes(); }
+    void writeJson(std::ostream& out) const override {
+        out << "\"singleCore\":" << scores.score << ", ";
+        out << "\"singleCoreHistory\":" << vectorToJsonArray(scores.history);
+    }
+
+private:
+    std::unique_ptr<CpuBenchmark> cpu;
+    CpuBenchmark::Scores scores = {};
+    size_t workingSet = 0;
+};
+
+class CpuMultiCoreKernel : public BenchmarkKernel {
+public:
+    void setup(const BenchmarkSizes& sizes) override {
+        cpu.reset(new CpuBenchmark(sizes));
+        workingSet = cpu->multiCoreWorkingSetBytes();
+    }
+    void run() override { scores = cpu->runMultiCoreSuite(); }
+    bool verify() override { return scores.score > 0.0; }
+    void teardown() override { cpu.reset(); }
+    double score() const override { return scores.score; }
+    int iterations() const override { return (int)scores.history.size(); }
+    size_t workingSetBytes() const override { return workingSet; }
+    static size_t workingSetHint(const BenchmarkSizes& sizes) { return CpuBenchmark(sizes).multiCoreWorkingSetBytes(); }
+    void writeJson(std::ostream& out) const override {
+        out << "\"multiCore\":" << scores.score << ", ";
+        out << "\"multiCoreHistory\":" << vectorToJsonArray(scores.history);
+    }
+
+private:
+    std::unique_ptr<CpuBenchmark> cpu;
+    CpuBenchmark::Scores scores = {};
+    size_t workingSet = 0;
+};
+
+// Scores are normalised so the reference device lands on 1000.
+static KernelRegistration<CpuSingleCoreKernel> singleCoreRegistration(
+        "cpu_single", "cpu", {"single_core", "compute"}, 1, 1000.0, 10);
+static KernelRegistration<CpuMultiCoreKernel> multiCoreRegistration(
+        "cpu_multi", "cpu", {"multi_core", "compute"}, 0, 1000.0, 20);
@@ -6,29 +6,49 @@
 #define PERFORMIC_CPUBENCHMARK_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include <vector>
+#include "BenchmarkSizes.h"
 
 class CpuBenchmark{
 public:
     struct Scores {
-        double singleCoreScore;
-        double multiCoreScore;
-        std::vector<double> singleCoreHistory;
-        std::vector<double> multiCoreHistory;
+        double score;                // average of history
+        std::vector<double> history; // one entry per stability iteration
     };
 
-    Scores runFullSuite();
+    explicit CpuBenchmark(const BenchmarkSizes& sizes);
+
+    // Matrix, integer, LU and compression on one thread (geometric mean).
+    Scores runSingleCoreSuite();
+    // Mandelbrot on every core.
+    Scores runMultiCoreSuite();
+
+    size_t singleCoreWorkingSetBytes() const;
+    size_t multiCoreWorkingSetBytes() const;
+
+    // Sizes the reference times were measured at. The scored tests always
+    // run at these sizes: scaling them would move a test between L2, LLC
+    // and DRAM, which changes the cost per flop / byte and breaks
+    // comparability with other presets and devices. Presets only change
+    // the number of iterations.
+    static constexpr int REF_MATRIX_SIZE = 300;
+    static constexpr int REF_INT_ARRAY_SIZE = 25000000;
+    static constexpr int REF_LU_MATRIX_SIZE = 500;
+    static constexpr int REF_COMPRESSION_SIZE = 1000000;
+    static constexpr int REF_MANDELBROT_SIZE = 500;
+    static constexpr int REF_MANDELBROT_ITER = 5000;
 
 private:
-    static constexpr int STABILITY_ITERATIONS = 15;
-    static constexpr int WARMUP_ITERATIONS = 5;
-    static constexpr int COMPRESSION_SIZE = 1000000;
-    static constexpr int MATRIX_SIZE = 300;
-    static constexpr int INT_ARRAY_SIZE = 25000000;
-    static constexpr int LU_MATRIX_SIZE = 500;
-
-    static constexpr int MANDELBROT_SIZE = 500;
-    static constexpr int MANDELBROT_ITER = 5000;
+    int stabilityIterations;
+    int warmupIterations;
+    int compressionSize;
+    int matrixSize;
+    int intArraySize;
+    int luMatrixSize;
+    int mandelbrotSize;
+    int mandelbrotIter;
+
     float performMatrixMultiplication();
     long performIntegerWorkload();
     bool performLUDecomposition();
@@ -0,0 +1,1138 @@
+#include "CryptoBenchmark.h"
+#include "utils.h"
+#include "CpuInfo.h"
+#include "BenchmarkRegistry.h"
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <sstream>
+#include <android/log.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#define LOG_TAG "PerformicCrypto"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+// --- CONFIGURATION ---
+constexpr int CTR_LANES = 8;              // AES blocks in flight (hides the AESE / AESENC latency)
+constexpr size_t OUTPUT_SLACK = 32;       // room for the GCM tag or a digest after the payload
+constexpr double SCALAR_BYTES_DIVISOR = 8.0;  // the scalar reference runs on 1/8 of the bytes
+
+#if defined(__clang__)
+#define UNROLL_FULL _Pragma("unroll")
+#else
+#define UNROLL_FULL _Pragma("GCC unroll 16")
+#endif
+
+static inline uint32_t loadBE32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void storeBE32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static inline void storeBE64(uint8_t* p, uint64_t v) {
+    storeBE32(p, (uint32_t)(v >> 32));
+    storeBE32(p + 4, (uint32_t)v);
+}
+
+// Both Android ABIs with hardware paths are little-endian.
+static inline uint32_t loadLE32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t loadLE64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint32_t rotr32(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+static inline uint64_t rotl64(uint64_t x, int n) { return (x << n) | (x >> (64 - n)); }
+
+// =========================================================
+// AES-128 (T-TABLES)
+// =========================================================
+
+struct AesTables {
+    uint8_t sbox[256];
+    uint32_t te[4][256];  // SubBytes + ShiftRows column + MixColumns, one per byte position
+};
+
+static inline uint8_t xtime(uint8_t x) {
+    return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0));
+}
+
+static inline uint8_t rotl8(uint8_t x, int n) {
+    return (uint8_t)((x << n) | (x >> (8 - n)));
+}
+
+// The S-box is generated rather than pasted: p walks GF(2^8)* by powers
+// of 3 while q walks the inverses (powers of 3^-1), then the affine map.
+static AesTables buildAesTables() {
+    AesTables t;
+    uint8_t p = 1, q = 1;
+    do {
+        p = (uint8_t)(p ^ xtime(p));
+        q ^= (uint8_t)(q << 1);
+        q ^= (uint8_t)(q << 2);
+        q ^= (uint8_t)(q << 4);
+        if (q & 0x80) q ^= 0x09;
+        t.sbox[p] = (uint8_t)(q ^ rotl8(q, 1) ^ rotl8(q, 2) ^ rotl8(q, 3) ^ rotl8(q, 4) ^ 0x63);
+    } while (p != 1);
+    t.sbox[0] = 0x63;
+
+    for (int i = 0; i < 256; ++i) {
+        uint8_t s = t.sbox[i];
+        uint32_t w = ((uint32_t)xtime(s) << 24) | ((uint32_t)s << 16) | ((uint32_t)s << 8) | (uint32_t)(xtime(s) ^ s);
+        t.te[0][i] = w;
+        t.te[1][i] = rotr32(w, 8);
+        t.te[2][i] = rotr32(w, 16);
+        t.te[3][i] = rotr32(w, 24);
+    }
+    return t;
+}
+
+static const AesTables& aesTables() {
+    static const AesTables tables = buildAesTables();
+    return tables;
+}
+
+struct AesKey {
+    uint32_t rk[44];     // round keys as big-endian words (T-table path)
+    uint8_t bytes[176];  // the same round keys in byte order (AES-NI / ARMv8 AESE)
+};
+
+static void aesExpandKey(AesKey& k, const uint8_t key[16]) {
+    const uint8_t* sbox = aesTables().sbox;
+    for (int i = 0; i < 4; ++i) k.rk[i] = loadBE32(key + 4 * i);
+
+    uint8_t rcon = 1;
+    for (int i = 4; i < 44; ++i) {
+        uint32_t w = k.rk[i - 1];
+        if (i % 4 == 0) {
+            w = (w << 8) | (w >> 24);
+            w = ((uint32_t)sbox[w >> 24] << 24) | ((uint32_t)sbox[(w >> 16) & 0xff] << 16) |
+                ((uint32_t)sbox[(w >> 8) & 0xff] << 8) | (uint32_t)sbox[w & 0xff];
+            w ^= (uint32_t)rcon << 24;
+            rcon = xtime(rcon);
+        }
+        k.rk[i] = k.rk[i - 4] ^ w;
+    }
+    for (int i = 0; i < 44; ++i) storeBE32(k.bytes + 4 * i, k.rk[i]);
+}
+
+static void aesEncryptBlockScalar(const AesKey& k, const uint8_t in[16], uint8_t out[16]) {
+    const AesTables& t = aesTables();
+    const uint32_t* rk = k.rk;
+    uint32_t s0 = loadBE32(in) ^ rk[0];
+    uint32_t s1 = loadBE32(in + 4) ^ rk[1];
+    uint32_t s2 = loadBE32(in + 8) ^ rk[2];
+    uint32_t s3 = loadBE32(in + 12) ^ rk[3];
+
+    for (int r = 1; r < 10; ++r) {
+        rk += 4;
+        uint32_t t0 = t.te[0][s0 >> 24] ^ t.te[1][(s1 >> 16) & 0xff] ^ t.te[2][(s2 >> 8) & 0xff] ^ t.te[3][s3 & 0xff] ^ rk[0];
+        uint32_t t1 = t.te[0][s1 >> 24] ^ t.te[1][(s2 >> 16) & 0xff] ^ t.te[2][(s3 >> 8) & 0xff] ^ t.te[3][s0 & 0xff] ^ rk[1];
+        uint32_t t2 = t.te[0][s2 >> 24] ^ t.te[1][(s3 >> 16) & 0xff] ^ t.te[2][(s0 >> 8) & 0xff] ^ t.te[3][s1 & 0xff] ^ rk[2];
+        uint32_t t3 = t.te[0][s3 >> 24] ^ t.te[1][(s0 >> 16) & 0xff] ^ t.te[2][(s1 >> 8) & 0xff] ^ t.te[3][s2 & 0xff] ^ rk[3];
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    // Last round: no MixColumns
+    rk += 4;
+    const uint8_t* sb = t.sbox;
+    uint32_t s[4] = { s0, s1, s2, s3 };
+    for (int c = 0; c < 4; ++c) {
+        uint32_t w = ((uint32_t)sb[s[c] >> 24] << 24) | ((uint32_t)sb[(s[(c + 1) % 4] >> 16) & 0xff] << 16) |
+                     ((uint32_t)sb[(s[(c + 2) % 4] >> 8) & 0xff] << 8) | (uint32_t)sb[s[(c + 3) % 4] & 0xff];
+        storeBE32(out + 4 * c, w ^ rk[c]);
+    }
+}
+
+// CTR with a 32-bit big-endian counter in the last four bytes (GCM inc32).
+typedef void (*AesCtrFn)(const AesKey& key, const uint8_t ctr0[16], const uint8_t* in, uint8_t* out, size_t len);
+
+static void aesCtrScalar(const AesKey& key, const uint8_t ctr0[16], const uint8_t* in, uint8_t* out, size_t len) {
+    uint8_t ctr[16], ks[16];
+    std::memcpy(ctr, ctr0, 16);
+    uint32_t c = loadBE32(ctr0 + 12);
+    for (size_t off = 0; off < len; off += 16) {
+        storeBE32(ctr + 12, c++);
+        aesEncryptBlockScalar(key, ctr, ks);
+        size_t n = std::min<size_t>(16, len - off);
+        for (size_t i = 0; i < n; ++i) out[off + i] = in[off + i] ^ ks[i];
+    }
+}
+
+// =========================================================
+// GHASH / GCM
+// =========================================================
+
+struct GcmKey {
+    uint64_t hl[16];      // 4-bit multiplication tables of H (scalar path)
+    uint64_t hh[16];
+    uint8_t hpow[4][16];  // H^1..H^4, the carry-less paths fold four blocks per reduction
+};
+
+// Reduction of the four bits shifted out of the 128-bit accumulator.
+static const uint16_t GHASH_LAST4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+// out = x * H in GF(2^128), 4 bits at a time (Shoup's method).
+static void gcmMultScalar(const GcmKey& g, const uint8_t x[16], uint8_t out[16]) {
+    uint8_t lo = x[15] & 0xf;
+    uint64_t zh = g.hh[lo];
+    uint64_t zl = g.hl[lo];
+
+    for (int i = 15; i >= 0; --i) {
+        lo = x[i] & 0xf;
+        uint8_t hi = (x[i] >> 4) & 0xf;
+        if (i != 15) {
+            uint8_t rem = (uint8_t)(zl & 0xf);
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((uint64_t)GHASH_LAST4[rem] << 48);
+            zh ^= g.hh[lo];
+            zl ^= g.hl[lo];
+        }
+        uint8_t rem = (uint8_t)(zl & 0xf);
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t)GHASH_LAST4[rem] << 48);
+        zh ^= g.hh[hi];
+        zl ^= g.hl[hi];
+    }
+    storeBE64(out, zh);
+    storeBE64(out + 8, zl);
+}
+
+static void gcmInitKey(GcmKey& g, const uint8_t h[16]) {
+    uint64_t vh = ((uint64_t)loadBE32(h) << 32) | loadBE32(h + 4);
+    uint64_t vl = ((uint64_t)loadBE32(h + 8) << 32) | loadBE32(h + 12);
+    g.hl[8] = vl;
+    g.hh[8] = vh;
+    g.hl[0] = 0;
+    g.hh[0] = 0;
+    for (int i = 4; i > 0; i >>= 1) {
+        uint32_t t = (uint32_t)(vl & 1) * 0xe1000000u;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ ((uint64_t)t << 32);
+        g.hl[i] = vl;
+        g.hh[i] = vh;
+    }
+    for (int i = 2; i <= 8; i *= 2) {
+        for (int j = 1; j < i; ++j) {
+            g.hh[i + j] = g.hh[i] ^ g.hh[j];
+            g.hl[i + j] = g.hl[i] ^ g.hl[j];
+        }
+    }
+
+    std::memcpy(g.hpow[0], h, 16);
+    for (int i = 1; i < 4; ++i) gcmMultScalar(g, g.hpow[i - 1], g.hpow[i]);
+}
+
+// Folds data into the running hash x; a partial last block is zero padded.
+typedef void (*GhashFn)(const GcmKey& key, uint8_t x[16], const uint8_t* data, size_t len);
+
+static void ghashScalar(const GcmKey& key, uint8_t x[16], const uint8_t* data, size_t len) {
+    for (size_t off = 0; off < len; off += 16) {
+        size_t n = std::min<size_t>(16, len - off);
+        for (size_t i = 0; i < n; ++i) x[i] ^= data[off + i];
+        gcmMultScalar(key, x, x);
+    }
+}
+
+struct CryptoKey {
+    AesKey aes;
+    GcmKey gcm;
+    uint8_t iv[16];  // CTR: initial counter block; GCM: 12-byte nonce
+    uint64_t seed;   // XXH64
+};
+
+// GCM encryption with a 96-bit nonce and no AAD: out = C || tag.
+static void gcmSeal(AesCtrFn ctr, GhashFn ghash, const CryptoKey& k, const uint8_t* in, size_t len, uint8_t* out) {
+    uint8_t j0[16], ctr1[16];
+    std::memcpy(j0, k.iv, 12);
+    storeBE32(j0 + 12, 1);
+    std::memcpy(ctr1, j0, 16);
+    storeBE32(ctr1 + 12, 2);
+    ctr(k.aes, ctr1, in, out, len);
+
+    uint8_t x[16] = {};
+    uint8_t lengths[16] = {};
+    storeBE64(lengths + 8, (uint64_t)len * 8);
+    ghash(k.gcm, x, out, len);
+    ghash(k.gcm, x, lengths, 16);
+
+    uint8_t zero[16] = {}, ekj0[16];
+    ctr(k.aes, j0, zero, ekj0, 16);
+    for (int i = 0; i < 16; ++i) out[len + i] = ekj0[i] ^ x[i];
+}
+
+// =========================================================
+// SHA-256
+// =========================================================
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+// Compresses whole 64-byte blocks into state.
+typedef void (*Sha256BlocksFn)(uint32_t state[8], const uint8_t* data, size_t blocks);
+
+static void sha256BlocksScalar(uint32_t state[8], const uint8_t* p, size_t blocks) {
+    for (; blocks > 0; --blocks, p += 64) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) w[i] = loadBE32(p + 4 * i);
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t t1 = h + (rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+            uint32_t t2 = (rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+static void sha256Digest(Sha256BlocksFn compress, const uint8_t* in, size_t len, uint8_t out[32]) {
+    uint32_t state[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    size_t full = len / 64;
+    compress(state, in, full);
+
+    uint8_t tail[128] = {};
+    size_t rem = len - full * 64;
+    if (rem > 0) std::memcpy(tail, in + full * 64, rem);
+    tail[rem] = 0x80;
+    size_t tailBlocks = rem < 56 ? 1 : 2;
+    storeBE64(tail + tailBlocks * 64 - 8, (uint64_t)len * 8);
+    compress(state, tail, tailBlocks);
+
+    for (int i = 0; i < 8; ++i) storeBE32(out + 4 * i, state[i]);
+}
+
+// =========================================================
+// CRC32C / XXH64
+// =========================================================
+
+// Whole-message CRC32C (Castagnoli, reflected 0x82F63B78), init and final xor ~0.
+typedef uint32_t (*Crc32cFn)(const uint8_t* data, size_t len);
+
+static const uint32_t* crc32cTables() {
+    static const struct Tables {
+        uint32_t t[8][256];
+        Tables() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = (c >> 1) ^ (0x82F63B78u & (0u - (c & 1)));
+                t[0][i] = c;
+            }
+            for (int s = 1; s < 8; ++s) {
+                for (int i = 0; i < 256; ++i) t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xff];
+            }
+        }
+    } tables;
+    return &tables.t[0][0];
+}
+
+// Slicing-by-8: one 8-byte word per step through eight 256-entry tables.
+static uint32_t crc32cScalar(const uint8_t* p, size_t len) {
+    const uint32_t* t = crc32cTables();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t w = loadLE64(p) ^ crc;
+        crc = t[7 * 256 + (w & 0xff)] ^ t[6 * 256 + ((w >> 8) & 0xff)] ^
+              t[5 * 256 + ((w >> 16) & 0xff)] ^ t[4 * 256 + ((w >> 24) & 0xff)] ^
+              t[3 * 256 + ((w >> 32) & 0xff)] ^ t[2 * 256 + ((w >> 40) & 0xff)] ^
+              t[1 * 256 + ((w >> 48) & 0xff)] ^ t[(w >> 56) & 0xff];
+    }
+    for (; len > 0; --len) crc = t[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+static const uint64_t XXH_P1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t XXH_P2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t XXH_P3 = 0x165667B19E3779F9ULL;
+static const uint64_t XXH_P4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t XXH_P5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t xxhRound(uint64_t acc, uint64_t input) {
+    acc += input * XXH_P2;
+    acc = rotl64(acc, 31);
+    return acc * XXH_P1;
+}
+
+static inline uint64_t xxhMerge(uint64_t h, uint64_t v) {
+    h ^= xxhRound(0, v);
+    return h * XXH_P1 + XXH_P4;
+}
+
+// XXH64. Four independent 64-bit multiply chains per 32-byte stripe are the
+// whole design, so the scalar code already is the fast path on both ISAs.
+static uint64_t xxh64(const uint8_t* p, size_t len, uint64_t seed) {
+    const uint8_t* end = p + len;
+    uint64_t h;
+    if (len >= 32) {
+        uint64_t v1 = seed + XXH_P1 + XXH_P2;
+        uint64_t v2 = seed + XXH_P2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_P1;
+        for (; p + 32 <= end; p += 32) {
+            v1 = xxhRound(v1, loadLE64(p));
+            v2 = xxhRound(v2, loadLE64(p + 8));
+            v3 = xxhRound(v3, loadLE64(p + 16));
+            v4 = xxhRound(v4, loadLE64(p + 24));
+        }
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xxhMerge(h, v1);
+        h = xxhMerge(h, v2);
+        h = xxhMerge(h, v3);
+        h = xxhMerge(h, v4);
+    } else {
+        h = seed + XXH_P5;
+    }
+    h += (uint64_t)len;
+
+    for (; p + 8 <= end; p += 8) {
+        h ^= xxhRound(0, loadLE64(p));
+        h = rotl64(h, 27) * XXH_P1 + XXH_P4;
+    }
+    if (p + 4 <= end) {
+        h ^= (uint64_t)loadLE32(p) * XXH_P1;
+        h = rotl64(h, 23) * XXH_P2 + XXH_P3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= (uint64_t)(*p) * XXH_P5;
+        h = rotl64(h, 11) * XXH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_P2;
+    h ^= h >> 29;
+    h *= XXH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+// =========================================================
+// ARMv8 CRYPTO EXTENSIONS
+// =========================================================
+
+typedef uint8_t  u8x16 __attribute__((vector_size(16)));
+typedef uint32_t u32x4 __attribute__((vector_size(16)));
+typedef uint64_t u64x2 __attribute__((vector_size(16)));
+
+#if defined(__aarch64__)
+// The crypto and crc extensions, used by selectAlgorithms() only when the
+// matching HWCAP is set. AESE+AESMC share one asm statement so cores that
+// fuse the pair always see them adjacent.
+#define AESE_MC(b, k) \
+    asm(".arch_extension crypto\n\taese %0.16b, %1.16b\n\taesmc %0.16b, %0.16b" : "+w"(b) : "w"(k))
+#define AESE(b, k) \
+    asm(".arch_extension crypto\n\taese %0.16b, %1.16b" : "+w"(b) : "w"(k))
+#define PMULL(r, a, b) \
+    asm(".arch_extension crypto\n\tpmull %0.1q, %1.1d, %2.1d" : "=w"(r) : "w"(a), "w"(b))
+#define PMULL2(r, a, b) \
+    asm(".arch_extension crypto\n\tpmull2 %0.1q, %1.2d, %2.2d" : "=w"(r) : "w"(a), "w"(b))
+#define SHA256H(abcd, efgh, wk) \
+    asm(".arch_extension crypto\n\tsha256h %q0, %q1, %2.4s" : "+w"(abcd) : "w"(efgh), "w"(wk))
+#define SHA256H2(efgh, abcd, wk) \
+    asm(".arch_extension crypto\n\tsha256h2 %q0, %q1, %2.4s" : "+w"(efgh) : "w"(abcd), "w"(wk))
+#define SHA256SU0(w0, w1) \
+    asm(".arch_extension crypto\n\tsha256su0 %0.4s, %1.4s" : "+w"(w0) : "w"(w1))
+#define SHA256SU1(w0, w2, w3) \
+    asm(".arch_extension crypto\n\tsha256su1 %0.4s, %1.4s, %2.4s" : "+w"(w0) : "w"(w2), "w"(w3))
+#define CRC32CX(crc, v) \
+    asm(".arch_extension crc\n\tcrc32cx %w0, %w0, %x1" : "+r"(crc) : "r"(v))
+#define CRC32CB(crc, v) \
+    asm(".arch_extension crc\n\tcrc32cb %w0, %w0, %w1" : "+r"(crc) : "r"(v))
+
+#define CLMUL_TARGET
+
+static inline u8x16 counterBlock(u8x16 base, uint32_t ctr) {
+    u32x4 c = (u32x4)base;
+    c[3] = __builtin_bswap32(ctr);
+    return (u8x16)c;
+}
+
+static inline u8x16 aesEncryptArm(u8x16 b, const u8x16* rk) {
+    for (int r = 0; r < 9; ++r) AESE_MC(b, rk[r]);
+    AESE(b, rk[9]);
+    return b ^ rk[10];
+}
+
+static void aesCtrArm(const AesKey& key, const uint8_t ctr0[16], const uint8_t* in, uint8_t* out, size_t len) {
+    u8x16 rk[11];
+    std::memcpy(rk, key.bytes, sizeof(rk));
+    u8x16 base;
+    std::memcpy(&base, ctr0, 16);
+    uint32_t ctr = loadBE32(ctr0 + 12);
+
+    size_t blocks = len / 16;
+    size_t i = 0;
+    for (; i + CTR_LANES <= blocks; i += CTR_LANES, ctr += CTR_LANES) {
+        u8x16 b[CTR_LANES];
+        UNROLL_FULL
+        for (int j = 0; j < CTR_LANES; ++j) b[j] = counterBlock(base, ctr + (uint32_t)j);
+        UNROLL_FULL
+        for (int r = 0; r < 9; ++r) {
+            UNROLL_FULL
+            for (int j = 0; j < CTR_LANES; ++j) AESE_MC(b[j], rk[r]);
+        }
+        UNROLL_FULL
+        for (int j = 0; j < CTR_LANES; ++j) {
+            AESE(b[j], rk[9]);
+            u8x16 d;
+            std::memcpy(&d, in + 16 * (i + j), 16);
+            d ^= b[j] ^ rk[10];
+            std::memcpy(out + 16 * (i + j), &d, 16);
+        }
+    }
+    for (; i < blocks; ++i, ++ctr) {
+        u8x16 d;
+        std::memcpy(&d, in + 16 * i, 16);
+        d ^= aesEncryptArm(counterBlock(base, ctr), rk);
+        std::memcpy(out + 16 * i, &d, 16);
+    }
+    size_t rem = len - blocks * 16;
+    if (rem > 0) {
+        u8x16 ks = aesEncryptArm(counterBlock(base, ctr), rk);
+        for (size_t k = 0; k < rem; ++k) out[blocks * 16 + k] = in[blocks * 16 + k] ^ ks[k];
+    }
+}
+
+static inline u64x2 clmulLo(u64x2 a, u64x2 b) {
+    u64x2 r;
+    PMULL(r, a, b);
+    return r;
+}
+
+static inline u64x2 clmulHi(u64x2 a, u64x2 b) {
+    u64x2 r;
+    PMULL2(r, a, b);
+    return r;
+}
+
+// a.lo * b.hi ^ a.hi * b.lo
+static inline u64x2 clmulCross(u64x2 a, u64x2 b) {
+    u64x2 s = __builtin_shufflevector(b, b, 1, 0);
+    return clmulLo(a, s) ^ clmulHi(a, s);
+}
+
+static void sha256BlocksArm(uint32_t state[8], const uint8_t* p, size_t blocks) {
+    u32x4 abcd, efgh;
+    std::memcpy(&abcd, state, 16);
+    std::memcpy(&efgh, state + 4, 16);
+
+    for (; blocks > 0; --blocks, p += 64) {
+        u32x4 abcdSave = abcd, efghSave = efgh;
+        u32x4 m[4];
+        for (int j = 0; j < 4; ++j) {
+            u8x16 b;
+            std::memcpy(&b, p + 16 * j, 16);
+            m[j] = (u32x4)__builtin_shufflevector(b, b, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        }
+        // Four rounds per step; the schedule runs three steps ahead.
+        UNROLL_FULL
+        for (int i = 0; i < 16; ++i) {
+            u32x4 k;
+            std::memcpy(&k, &SHA256_K[4 * i], 16);
+            u32x4 wk = m[i % 4] + k;
+            if (i < 12) {
+                SHA256SU0(m[i % 4], m[(i + 1) % 4]);
+                SHA256SU1(m[i % 4], m[(i + 2) % 4], m[(i + 3) % 4]);
+            }
+            u32x4 prev = abcd;
+            SHA256H(abcd, efgh, wk);
+            SHA256H2(efgh, prev, wk);
+        }
+        abcd += abcdSave;
+        efgh += efghSave;
+    }
+
+    std::memcpy(state, &abcd, 16);
+    std::memcpy(state + 4, &efgh, 16);
+}
+
+static uint32_t crc32cArm(const uint8_t* p, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t w = loadLE64(p);
+        CRC32CX(crc, w);
+    }
+    for (; len > 0; --len) {
+        uint32_t b = *p++;
+        CRC32CB(crc, b);
+    }
+    return ~crc;
+}
+#endif
+
+// =========================================================
+// x86 AES-NI / PCLMULQDQ / SHA-NI / SSE4.2
+// =========================================================
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AES_TARGET __attribute__((target("aes,sse4.1")))
+#define CLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+#define SHA_TARGET __attribute__((target("sha,sse4.1")))
+#define CRC_TARGET __attribute__((target("sse4.2")))
+
+AES_TARGET static inline __m128i counterBlock(__m128i base, uint32_t ctr) {
+    return _mm_insert_epi32(base, (int)__builtin_bswap32(ctr), 3);
+}
+
+AES_TARGET static inline __m128i aesEncryptNi(__m128i b, const __m128i* rk) {
+    b = _mm_xor_si128(b, rk[0]);
+    for (int r = 1; r < 10; ++r) b = _mm_aesenc_si128(b, rk[r]);
+    return _mm_aesenclast_si128(b, rk[10]);
+}
+
+AES_TARGET static void aesCtrNi(const AesKey& key, const uint8_t ctr0[16], const uint8_t* in, uint8_t* out, size_t len) {
+    __m128i rk[11];
+    for (int r = 0; r < 11; ++r) rk[r] = _mm_loadu_si128((const __m128i*)(key.bytes + 16 * r));
+    __m128i base = _mm_loadu_si128((const __m128i*)ctr0);
+    uint32_t ctr = loadBE32(ctr0 + 12);
+
+    size_t blocks = len / 16;
+    size_t i = 0;
+    for (; i + CTR_LANES <= blocks; i += CTR_LANES, ctr += CTR_LANES) {
+        __m128i b[CTR_LANES];
+        UNROLL_FULL
+        for (int j = 0; j < CTR_LANES; ++j) b[j] = _mm_xor_si128(counterBlock(base, ctr + (uint32_t)j), rk[0]);
+        UNROLL_FULL
+        for (int r = 1; r < 10; ++r) {
+            UNROLL_FULL
+            for (int j = 0; j < CTR_LANES; ++j) b[j] = _mm_aesenc_si128(b[j], rk[r]);
+        }
+        UNROLL_FULL
+        for (int j = 0; j < CTR_LANES; ++j) {
+            b[j] = _mm_aesenclast_si128(b[j], rk[10]);
+            __m128i d = _mm_loadu_si128((const __m128i*)(in + 16 * (i + j)));
+            _mm_storeu_si128((__m128i*)(out + 16 * (i + j)), _mm_xor_si128(d, b[j]));
+        }
+    }
+    for (; i < blocks; ++i, ++ctr) {
+        __m128i d = _mm_loadu_si128((const __m128i*)(in + 16 * i));
+        _mm_storeu_si128((__m128i*)(out + 16 * i), _mm_xor_si128(d, aesEncryptNi(counterBlock(base, ctr), rk)));
+    }
+    size_t rem = len - blocks * 16;
+    if (rem > 0) {
+        uint8_t ks[16];
+        _mm_storeu_si128((__m128i*)ks, aesEncryptNi(counterBlock(base, ctr), rk));
+        for (size_t k = 0; k < rem; ++k) out[blocks * 16 + k] = in[blocks * 16 + k] ^ ks[k];
+    }
+}
+
+CLMUL_TARGET static inline u64x2 clmulLo(u64x2 a, u64x2 b) {
+    return (u64x2)_mm_clmulepi64_si128((__m128i)a, (__m128i)b, 0x00);
+}
+
+CLMUL_TARGET static inline u64x2 clmulHi(u64x2 a, u64x2 b) {
+    return (u64x2)_mm_clmulepi64_si128((__m128i)a, (__m128i)b, 0x11);
+}
+
+// a.lo * b.hi ^ a.hi * b.lo
+CLMUL_TARGET static inline u64x2 clmulCross(u64x2 a, u64x2 b) {
+    return (u64x2)_mm_xor_si128(_mm_clmulepi64_si128((__m128i)a, (__m128i)b, 0x10),
+                                _mm_clmulepi64_si128((__m128i)a, (__m128i)b, 0x01));
+}
+
+// ABEF / CDGH register layout of SHA256RNDS2; two rounds per instruction.
+SHA_TARGET static void sha256BlocksShaNi(uint32_t state[8], const uint8_t* p, size_t blocks) {
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1);  // CDAB
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B);  // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);  // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);       // CDGH
+
+    for (; blocks > 0; --blocks, p += 64) {
+        __m128i abefSave = state0, cdghSave = state1;
+        __m128i m[4];
+        // Four rounds per step; MSG1 / MSG2 keep the schedule three steps ahead.
+        UNROLL_FULL
+        for (int i = 0; i < 16; ++i) {
+            if (i < 4) m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(p + 16 * i)), MASK);
+            __m128i msg = _mm_add_epi32(m[i % 4], _mm_loadu_si128((const __m128i*)&SHA256_K[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (i >= 3 && i <= 14) {
+                __m128i t = _mm_alignr_epi8(m[i % 4], m[(i + 3) % 4], 4);
+                m[(i + 1) % 4] = _mm_sha256msg2_epu32(_mm_add_epi32(m[(i + 1) % 4], t), m[i % 4]);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (i >= 1 && i <= 12) m[(i + 3) % 4] = _mm_sha256msg1_epu32(m[(i + 3) % 4], m[i % 4]);
+        }
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);        // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);     // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);  // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);     // HGFE
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+}
+
+CRC_TARGET static uint32_t crc32cSse42(const uint8_t* p, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+#if defined(__x86_64__)
+    uint64_t c = crc;
+    for (; len >= 8; len -= 8, p += 8) c = _mm_crc32_u64(c, loadLE64(p));
+    crc = (uint32_t)c;
+#endif
+    for (; len >= 4; len -= 4, p += 4) crc = _mm_crc32_u32(crc, loadLE32(p));
+    for (; len > 0; --len) crc = _mm_crc32_u8(crc, *p++);
+    return ~crc;
+}
+#endif
+
+// =========================================================
+// CARRY-LESS GHASH (PMULL / PCLMULQDQ)
+// =========================================================
+// Operands are byte reversed so GCM's reflected bit order becomes a plain
+// polynomial product, shifted left by one and reduced modulo
+// x^128 + x^7 + x^2 + x + 1 (Gueron & Kounavis). The reduction is written
+// once in vector extensions; only the 64x64 multiply is per ISA.
+
+#if defined(__aarch64__) || defined(__x86_64__) || defined(__i386__)
+CLMUL_TARGET static inline u64x2 loadSwapped(const uint8_t* p) {
+    u8x16 v;
+    std::memcpy(&v, p, 16);
+    return (u64x2)__builtin_shufflevector(v, v, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+}
+
+CLMUL_TARGET static inline void storeSwapped(uint8_t* p, u64x2 x) {
+    u8x16 v = (u8x16)x;
+    v = __builtin_shufflevector(v, v, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    std::memcpy(p, &v, 16);
+}
+
+// Unreduced 256-bit product hi:lo.
+CLMUL_TARGET static inline void clmulWide(u64x2 a, u64x2 b, u64x2& lo, u64x2& hi) {
+    u64x2 mid = clmulCross(a, b);
+    lo = clmulLo(a, b) ^ (u64x2){ 0, mid[0] };
+    hi = clmulHi(a, b) ^ (u64x2){ mid[1], 0 };
+}
+
+CLMUL_TARGET static inline u64x2 ghashReduce(u64x2 lo, u64x2 hi) {
+    const u32x4 zero = {};
+    u32x4 t3 = (u32x4)lo;
+    u32x4 t6 = (u32x4)hi;
+
+    // hi:lo <<= 1
+    u32x4 c3 = t3 >> 31;
+    u32x4 c6 = t6 >> 31;
+    t3 = (t3 << 1) | __builtin_shufflevector(zero, c3, 0, 4, 5, 6);
+    t6 = (t6 << 1) | __builtin_shufflevector(zero, c6, 0, 4, 5, 6) | __builtin_shufflevector(c3, zero, 3, 4, 4, 4);
+
+    // First phase: fold the low word
+    u32x4 a = (t3 << 31) ^ (t3 << 30) ^ (t3 << 25);
+    u32x4 carry = __builtin_shufflevector(a, zero, 1, 2, 3, 4);
+    t3 ^= __builtin_shufflevector(zero, a, 0, 1, 2, 4);
+
+    // Second phase
+    u32x4 b = (t3 >> 1) ^ (t3 >> 2) ^ (t3 >> 7) ^ carry;
+    return (u64x2)(t6 ^ t3 ^ b);
+}
+
+// Four blocks per reduction: X' = (X ^ C0) H^4 ^ C1 H^3 ^ C2 H^2 ^ C3 H.
+CLMUL_TARGET static void ghashClmul(const GcmKey& key, uint8_t x[16], const uint8_t* data, size_t len) {
+    const u64x2 h1 = loadSwapped(key.hpow[0]);
+    const u64x2 h2 = loadSwapped(key.hpow[1]);
+    const u64x2 h3 = loadSwapped(key.hpow[2]);
+    const u64x2 h4 = loadSwapped(key.hpow[3]);
+    u64x2 acc = loadSwapped(x);
+
+    size_t blocks = len / 16;
+    for (; blocks >= 4; blocks -= 4, data += 64) {
+        u64x2 lo, hi, l, h;
+        clmulWide(loadSwapped(data) ^ acc, h4, lo, hi);
+        clmulWide(loadSwapped(data + 16), h3, l, h);
+        lo ^= l; hi ^= h;
+        clmulWide(loadSwapped(data + 32), h2, l, h);
+        lo ^= l; hi ^= h;
+        clmulWide(loadSwapped(data + 48), h1, l, h);
+        lo ^= l; hi ^= h;
+        acc = ghashReduce(lo, hi);
+    }
+    for (; blocks > 0; --blocks, data += 16) {
+        u64x2 lo, hi;
+        clmulWide(loadSwapped(data) ^ acc, h1, lo, hi);
+        acc = ghashReduce(lo, hi);
+    }
+    size_t rem = len % 16;
+    if (rem > 0) {
+        uint8_t last[16] = {};
+        std::memcpy(last, data, rem);
+        u64x2 lo, hi;
+        clmulWide(loadSwapped(last) ^ acc, h1, lo, hi);
+        acc = ghashReduce(lo, hi);
+    }
+    storeSwapped(x, acc);
+}
+#endif
+
+// =========================================================
+// ALGORITHMS
+// =========================================================
+// Every algorithm is driven through one signature. out receives the
+// ciphertext (plus the 16-byte tag for GCM) or the big-endian digest.
+
+typedef void (*MessageFn)(const CryptoKey& key, const uint8_t* in, size_t len, uint8_t* out);
+
+template <AesCtrFn CTR, GhashFn GHASH>
+static void gcmMessage(const CryptoKey& key, const uint8_t* in, size_t len, uint8_t* out) {
+    gcmSeal(CTR, GHASH, key, in, len, out);
+}
+
+template <AesCtrFn CTR>
+static void ctrMessage(const CryptoKey& key, const uint8_t* in, size_t len, uint8_t* out) {
+    CTR(key.aes, key.iv, in, out, len);
+}
+
+template <Sha256BlocksFn COMPRESS>
+static void sha256Message(const CryptoKey&, const uint8_t* in, size_t len, uint8_t* out) {
+    sha256Digest(COMPRESS, in, len, out);
+}
+
+template <Crc32cFn CRC>
+static void crc32cMessage(const CryptoKey&, const uint8_t* in, size_t len, uint8_t* out) {
+    storeBE32(out, CRC(in, len));
+}
+
+static void xxh64Message(const CryptoKey& key, const uint8_t* in, size_t len, uint8_t* out) {
+    storeBE64(out, xxh64(in, len, key.seed));
+}
+
+enum AlgorithmId { AES_GCM, AES_CTR, SHA256, CRC32C, XXH64, ALGORITHM_COUNT };
+
+struct Algorithm {
+    const char* name;
+    MessageFn scalar;
+    MessageFn fast;    // == scalar when the CPU lacks the instructions
+    std::string path;
+};
+
+static std::vector<Algorithm> selectAlgorithms() {
+    std::vector<Algorithm> algos = {
+        { "aes128_gcm", gcmMessage<aesCtrScalar, ghashScalar>, gcmMessage<aesCtrScalar, ghashScalar>, "scalar" },
+        { "aes128_ctr", ctrMessage<aesCtrScalar>, ctrMessage<aesCtrScalar>, "scalar" },
+        { "sha256", sha256Message<sha256BlocksScalar>, sha256Message<sha256BlocksScalar>, "scalar" },
+        { "crc32c", crc32cMessage<crc32cScalar>, crc32cMessage<crc32cScalar>, "scalar" },
+        { "xxh64", xxh64Message, xxh64Message, "scalar" },
+    };
+
+    const CpuInfo::Features& isa = CpuInfo::features();
+#if defined(__aarch64__)
+    if (isa.aes && isa.pmull) { algos[AES_GCM].fast = gcmMessage<aesCtrArm, ghashClmul>; algos[AES_GCM].path = "aes+pmull"; }
+    if (isa.aes) { algos[AES_CTR].fast = ctrMessage<aesCtrArm>; algos[AES_CTR].path = "aes"; }
+    if (isa.sha2) { algos[SHA256].fast = sha256Message<sha256BlocksArm>; algos[SHA256].path = "sha2"; }
+    if (isa.crc32) { algos[CRC32C].fast = crc32cMessage<crc32cArm>; algos[CRC32C].path = "crc32"; }
+#elif defined(__x86_64__) || defined(__i386__)
+    if (isa.aesni && isa.pclmul) { algos[AES_GCM].fast = gcmMessage<aesCtrNi, ghashClmul>; algos[AES_GCM].path = "aesni+pclmul"; }
+    if (isa.aesni) { algos[AES_CTR].fast = ctrMessage<aesCtrNi>; algos[AES_CTR].path = "aesni"; }
+    if (isa.shani) { algos[SHA256].fast = sha256Message<sha256BlocksShaNi>; algos[SHA256].path = "shani"; }
+    if (isa.sse42) { algos[CRC32C].fast = crc32cMessage<crc32cSse42>; algos[CRC32C].path = "sse4.2"; }
+#endif
+    (void)isa;
+    return algos;
+}
+
+static void initCryptoKey(CryptoKey& k, const uint8_t key[16], const uint8_t* iv, size_t ivBytes, uint64_t seed) {
+    aesExpandKey(k.aes, key);
+    uint8_t zero[16] = {}, h[16];
+    aesEncryptBlockScalar(k.aes, zero, h);
+    gcmInitKey(k.gcm, h);
+    std::memset(k.iv, 0, sizeof(k.iv));
+    if (ivBytes > 0) std::memcpy(k.iv, iv, std::min<size_t>(ivBytes, sizeof(k.iv)));
+    k.seed = seed;
+}
+
+// =========================================================
+// VERIFICATION
+// =========================================================
+
+struct KnownAnswer {
+    AlgorithmId algorithm;
+    const char* key;       // hex, AES only (nullptr = all zero)
+    const char* iv;        // hex, CTR: counter block, GCM: 96-bit nonce
+    uint64_t seed;         // XXH64
+    const char* input;     // hex; nullptr = bytes 0..255 four times
+    const char* expected;  // hex; GCM: ciphertext || tag
+};
+
+// FIPS-197 C.1 (as one CTR block), SP 800-38A F.5.1, the GCM spec test
+// cases 1-3, FIPS 180-2, RFC 3720 and the xxHash reference implementation.
+static const KnownAnswer KNOWN_ANSWERS[] = {
+    { AES_CTR, "000102030405060708090a0b0c0d0e0f", "00112233445566778899aabbccddeeff", 0,
+      "00000000000000000000000000000000", "69c4e0d86a7b0430d8cdb78070b4c55a" },
+    { AES_CTR, "2b7e151628aed2a6abf7158809cf4f3c", "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff", 0,
+      "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51",
+      "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff" },
+    { AES_GCM, nullptr, "000000000000000000000000", 0, "", "58e2fccefa7e3061367f1d57a4e7455a" },
+    { AES_GCM, nullptr, "000000000000000000000000", 0, "00000000000000000000000000000000",
+      "0388dace60b6a392f328c2b971b2fe78ab6e47d42cec13bdf53a67b21257bddf" },
+    { AES_GCM, "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", 0,
+      "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+      "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+      "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+      "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985"
+      "4d5c2af327cd64a62cf35abd2ba6fab4" },
+    { SHA256, nullptr, nullptr, 0, "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+    { SHA256, nullptr, nullptr, 0, "616263", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+    { SHA256, nullptr, nullptr, 0,
+      "6162636462636465636465666465666765666768666768696768696a68696a6b696a6b6c6a6b6c6d6b6c6d6e6c6d6e6f6d6e6f706e6f7071",
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+    { SHA256, nullptr, nullptr, 0, nullptr, "785b0751fc2c53dc14a4ce3d800e69ef9ce1009eb327ccf458afe09c242c26c9" },
+    { CRC32C, nullptr, nullptr, 0, "313233343536373839", "e3069283" },
+    { CRC32C, nullptr, nullptr, 0, "0000000000000000000000000000000000000000000000000000000000000000", "8a9136aa" },
+    { CRC32C, nullptr, nullptr, 0, nullptr, "2cdf6e8f" },
+    { XXH64, nullptr, nullptr, 0, "", "ef46db3751d8e999" },
+    { XXH64, nullptr, nullptr, 0, "616263", "44bc2cf5ad770999" },
+    { XXH64, nullptr, nullptr, 1, "616263", "bea9ca8199328908" },
+    { XXH64, nullptr, nullptr, 0,
+      "54686520717569636b2062726f776e20666f78206a756d7073206f76657220746865206c617a7920646f67", "0b242d361fda71bc" },
+    { XXH64, nullptr, nullptr, 0, nullptr, "6f3914f18fe4df57" },
+    { XXH64, nullptr, nullptr, 0x9E3779B97F4A7C15ULL, nullptr, "22d0f4503bcda26a" },
+};
+
+static std::vector<uint8_t> fromHex(const char* hex) {
+    std::vector<uint8_t> bytes;
+    if (!hex) return bytes;
+    auto nibble = [](char c) { return (uint8_t)(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10); };
+    for (size_t i = 0; hex[i] && hex[i + 1]; i += 2) {
+        bytes.push_back((uint8_t)((nibble(hex[i]) << 4) | nibble(hex[i + 1])));
+    }
+    return bytes;
+}
+
+static void fillPattern(std::vector<uint8_t>& buf, uint64_t seed) {
+    uint64_t s = seed * 0x9E3779B97F4A7C15ULL + 1;
+    for (size_t i = 0; i < buf.size(); ++i) {
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        buf[i] = (uint8_t)(s >> 32);
+    }
+}
+
+// Published vectors through both the scalar and the selected path.
+static bool checkKnownAnswers(const std::vector<Algorithm>& algos) {
+    bool ok = true;
+    for (const KnownAnswer& ka : KNOWN_ANSWERS) {
+        std::vector<uint8_t> key = fromHex(ka.key);
+        key.resize(16, 0);
+        std::vector<uint8_t> iv = fromHex(ka.iv);
+        CryptoKey k;
+        initCryptoKey(k, key.data(), iv.data(), iv.size(), ka.seed);
+
+        std::vector<uint8_t> input;
+        if (ka.input) {
+            input = fromHex(ka.input);
+        } else {
+            for (int i = 0; i < 1024; ++i) input.push_back((uint8_t)i);
+        }
+        std::vector<uint8_t> expected = fromHex(ka.expected);
+
+        const Algorithm& a = algos[ka.algorithm];
+        MessageFn fns[2] = { a.scalar, a.fast };
+        for (int f = 0; f < 2; ++f) {
+            std::vector<uint8_t> out(input.size() + OUTPUT_SLACK, 0);
+            fns[f](k, input.data(), input.size(), out.data());
+            if (std::memcmp(out.data(), expected.data(), expected.size()) != 0) {
+                LOGE("%s known-answer mismatch (%s, %zu bytes)", a.name, f == 0 ? "scalar" : a.path.c_str(), input.size());
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+// Lengths around the block, padding and lane boundaries of every path.
+static bool checkAgainstScalar(const Algorithm& a, const CryptoKey& key) {
+    static const size_t LENGTHS[] = { 0, 1, 15, 16, 17, 55, 56, 63, 64, 65, 127, 128, 129, 1000, 4099, 65539 };
+    std::vector<uint8_t> in(65539);
+    fillPattern(in, 7);
+
+    for (size_t len : LENGTHS) {
+        std::vector<uint8_t> ref(len + OUTPUT_SLACK, 0), out(len + OUTPUT_SLACK, 0);
+        a.scalar(key, in.data(), len, ref.data());
+        a.fast(key, in.data(), len, out.data());
+        if (out != ref) {
+            LOGE("%s (%s) differs from scalar at %zu bytes", a.name, a.path.c_str(), len);
+            return false;
+        }
+    }
+    return true;
+}
+
+// =========================================================
+// MEASUREMENT
+// =========================================================
+
+// GB/s of fn over messages of msgBytes, best of `repeats`. Each thread
+// processes `bytes` worth of messages from its own buffers.
+static double measureGBs(MessageFn fn, const CryptoKey& key, size_t msgBytes, double bytes,
+                         unsigned int numThreads, int repeats) {
+    long messages = std::max(1L, (long)(bytes / (double)msgBytes));
+    std::vector<std::vector<uint8_t>> in(numThreads), out(numThreads);
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        in[t].resize(msgBytes);
+        fillPattern(in[t], t + 1);
+        out[t].assign(msgBytes + OUTPUT_SLACK, 0);
+    }
+
+    double best = 0.0;
+    for (int rep = 0; rep < repeats; ++rep) {
+        double sec = timeSeconds([&]() {
+            parallelFor(numThreads, [&](unsigned int t) {
+                const uint8_t* src = in[t].data();
+                uint8_t* dst = out[t].data();
+                for (long m = 0; m < messages; ++m) fn(key, src, msgBytes, dst);
+            });
+        });
+        if (rep == 0 || sec < best) best = sec;
+    }
+    for (unsigned int t = 0; t < numThreads; ++t) DoNotOptimize(out[t][0]);
+
+    return (double)numThreads * (double)messages * (double)msgBytes / std::max(best, 1e-9) / 1e9;
+}
+
+CryptoBenchmark::CryptoBenchmark(const BenchmarkSizes& sizes)
+        : smallBytes(sizes.cryptoSmallBytes), largeBytes(sizes.cryptoLargeBytes),
+          bytesPerMeasurement(sizes.cryptoBytes), cryptoRepeats(sizes.cryptoRepeats) {}
+
+CryptoBenchmark::CryptoScores CryptoBenchmark::runCryptoSuite() {
+    LOGD("--- STARTING CRYPTO BENCHMARK ---");
+
+    CryptoScores scores;
+    scores.smallBytes = smallBytes;
+    scores.largeBytes = largeBytes;
+    scores.verified = true;
+    std::vector<Algorithm> algos = selectAlgorithms();
+    unsigned int numCores = CpuInfo::coreCount();
+
+    // GCM test case 3 key / nonce
+    std::vector<uint8_t> keyBytes = fromHex("feffe9928665731c6d6a8f9467308308");
+    std::vector<uint8_t> iv = fromHex("cafebabefacedbaddecaf888");
+    CryptoKey key;
+    initCryptoKey(key, keyBytes.data(), iv.data(), iv.size(), 0x9E3779B97F4A7C15ULL);
+
+    // 1. Verification
+    if (!checkKnownAnswers(algos)) scores.verified = false;
+    for (const Algorithm& a : algos) {
+        if (!checkAgainstScalar(a, key)) scores.verified = false;
+    }
+
+    // 2. Throughput
+    for (const Algorithm& a : algos) {
+        AlgorithmResult r;
+        r.name = a.name;
+        r.path = a.path;
+        r.small.singleCoreGBs = measureGBs(a.fast, key, smallBytes, bytesPerMeasurement, 1, cryptoRepeats);
+        r.small.multiCoreGBs = measureGBs(a.fast, key, smallBytes, bytesPerMeasurement, numCores, cryptoRepeats);
+        r.large.singleCoreGBs = measureGBs(a.fast, key, largeBytes, bytesPerMeasurement, 1, cryptoRepeats);
+        r.large.multiCoreGBs = measureGBs(a.fast, key, largeBytes, bytesPerMeasurement, numCores, cryptoRepeats);
+        r.scalarLargeSingleGBs = a.fast == a.scalar
+                ? r.large.singleCoreGBs
+                : measureGBs(a.scalar, key, largeBytes, bytesPerMeasurement / SCALAR_BYTES_DIVISOR, 1, 1);
+        LOGD("%s (%s): small %.2f / %.2f GB/s, large %.2f / %.2f GB/s, scalar %.2f GB/s", r.name.c_str(),
+             r.path.c_str(), r.small.singleCoreGBs, r.small.multiCoreGBs, r.large.singleCoreGBs,
+             r.large.multiCoreGBs, r.scalarLargeSingleGBs);
+        scores.algorithms.push_back(r);
+    }
+
+    if (!scores.verified) LOGE("Crypto verification FAILED");
+    return scores;
+}
+
+size_t CryptoBenchmark::workingSetBytes() const {
+    // Input + output message per thread.
+    return (size_t)CpuInfo::coreCount() * 2 * (largeBytes + OUTPUT_SLACK);
+}
+
+// =========================================================
+// REGISTRATION
+// =========================================================
+
+static std::string throughputToJson(const CryptoBenchmark::Throughput& t) {
+    std::stringstream ss;
+    ss << "{\"singleGBs\":" << t.singleCoreGBs << ", \"multiGBs\":" << t.multiCoreGBs << "}";
+    return ss.str();
+}
+
+// One algorithm at both message sizes, plus its scalar reference.
+static std::string algorithmResultToJson(const CryptoBenchmark::AlgorithmResult& a) {
+    std::stringstream ss;
+    ss << "{";
+    ss << "\"name\":\"" << a.name << "\", ";
+    ss << "\"path\":\"" << a.path << "\", ";
+    ss << "\"small\":" << throughputToJson(a.small) << ", ";
+    ss << "\"large\":" << throughputToJson(a.large) << ", ";
+    ss << "\"scalarLargeSingleGBs\":" << a.scalarLargeSingleGBs;
+    ss << "}";
+    return ss.str();
+}
+
+class CryptoKernel : public BenchmarkKernel {
+public:
+    void setup(const BenchmarkSizes& sizes) override {
+        crypto.reset(new CryptoBenchmark(sizes));
+        workingSet = crypto->workingSetBytes();
+    }
+    void run() override { scores = crypto->runCryptoSuite(); }
+    bool verify() override { return scores.verified; }
+    void teardown() override { crypto.reset(); }
+    // AES-128-GCM on large messages, all cores
+    double score() const override {
+        return scores.algorithms.empty() ? 0.0 : scores.algorithms[AES_GCM].large.multiCoreGBs;
+    }
+    size_t workingSetBytes() const override { return workingSet; }
+    static size_t workingSetHint(const BenchmarkSizes& sizes) { return CryptoBenchmark(sizes).workingSetBytes(); }
+    void writeJson(std::ostream& out) const override {
+        out << "\"crypto\":{";
+        out << "\"verified\":" << (scores.verified ? "true" : "false") << ", ";
+        out << "\"smallBytes\":" << scores.smallBytes << ", ";
+        out << "\"largeBytes\":" << scores.largeBytes << ", ";
+        out << "\"algorithms\":" << jsonArray(scores.algorithms, algorithmResultToJson);
+        out << "}";
+    }
+
+private:
+    std::unique_ptr<CryptoBenchmark> crypto;
+    CryptoBenchmark::CryptoScores scores = {};
+    size_t workingSet = 0;
+};
+
+static KernelRegistration<CryptoKernel> registration(
+        "crypto", "crypto", {"single_core", "multi_core", "integer"}, 0, 0.0, 80);
@@ -0,0 +1,53 @@
+//
+// Created by Marius on 18/10/2026.
+//
+
+#ifndef PERFORMIC_CRYPTOBENCHMARK_H
+#define PERFORMIC_CRYPTOBENCHMARK_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "BenchmarkSizes.h"
+
+// Bulk crypto / checksum throughput: AES-128-GCM, AES-128-CTR, SHA-256,
+// CRC32C and XXH64. Each algorithm runs on the fastest path the CPU offers
+// (ARMv8 AES/PMULL/SHA2/CRC32, x86 AES-NI/PCLMULQDQ/SHA-NI/SSE4.2) and on a
+// portable scalar path. The scalar paths are checked against published
+// known-answer vectors, the hardware paths must match them byte for byte.
+class CryptoBenchmark {
+public:
+    struct Throughput {
+        double singleCoreGBs;
+        double multiCoreGBs;  // all cores, each hashing its own buffers
+    };
+
+    struct AlgorithmResult {
+        std::string name;             // "aes128_gcm", "aes128_ctr", "sha256", "crc32c", "xxh64"
+        std::string path;             // e.g. "aesni+pclmul", "sha2", "scalar"
+        Throughput small;             // cryptoSmallBytes messages (per-message setup dominates)
+        Throughput large;             // cryptoLargeBytes messages (streaming)
+        double scalarLargeSingleGBs;  // portable path, one core
+    };
+
+    struct CryptoScores {
+        size_t smallBytes;
+        size_t largeBytes;
+        std::vector<AlgorithmResult> algorithms;
+        bool verified;
+    };
+
+    explicit CryptoBenchmark(const BenchmarkSizes& sizes);
+
+    CryptoScores runCryptoSuite();
+
+    size_t workingSetBytes() const;
+
+private:
+    size_t smallBytes;
+    size_t largeBytes;
+    double bytesPerMeasurement;
+    int cryptoRepeats;
+};
+
+#endif //PERFORMIC_CRYPTOBENCHMARK_H
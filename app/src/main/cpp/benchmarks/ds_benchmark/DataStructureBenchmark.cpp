@@ -0,0 +1,503 @@
+#include "DataStructureBenchmark.h"
+#include "utils.h"
+#include "CpuInfo.h"
+#include "BenchmarkRegistry.h"
+#include <algorithm>
+#include <sstream>
+#include <android/log.h>
+
+#define LOG_TAG "PerformicDS"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+// --- CONFIGURATION ---
+constexpr int RADIX_BITS = 8;
+constexpr int RADIX_BUCKETS = 1 << RADIX_BITS;
+constexpr int SAMPLE_OVERSAMPLING = 64; // samples per bucket when picking splitters
+constexpr int MIXED_HIT_PERCENT = 75;   // hits in the mixed lookup pass, in random order
+
+static inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static inline size_t chunkBegin(size_t n, unsigned int t, unsigned int numThreads) {
+    return n * t / numThreads;
+}
+
+// =========================================================
+// SORTING
+// =========================================================
+
+// Stable LSD radix sort, one 8-bit digit per pass.
+// Every thread histograms its own slice, a prefix sum over (digit, thread)
+// gives each thread private output ranges, then every thread scatters.
+static void radixSort(std::vector<uint32_t>& keys, std::vector<uint32_t>& tmp, unsigned int numThreads) {
+    size_t n = keys.size();
+    std::vector<size_t> counts((size_t)numThreads * RADIX_BUCKETS);
+    uint32_t* src = keys.data();
+    uint32_t* dst = tmp.data();
+
+    for (int shift = 0; shift < 32; shift += RADIX_BITS) {
+        std::fill(counts.begin(), counts.end(), 0);
+
+        parallelFor(numThreads, [&](unsigned int t) {
+            size_t* local = &counts[(size_t)t * RADIX_BUCKETS];
+            for (size_t i = chunkBegin(n, t, numThreads); i < chunkBegin(n, t + 1, numThreads); ++i) {
+                local[(src[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+            }
+        });
+
+        size_t offset = 0;
+        for (int d = 0; d < RADIX_BUCKETS; ++d) {
+            for (unsigned int t = 0; t < numThreads; ++t) {
+                size_t c = counts[(size_t)t * RADIX_BUCKETS + d];
+                counts[(size_t)t * RADIX_BUCKETS + d] = offset;
+                offset += c;
+            }
+        }
+
+        parallelFor(numThreads, [&](unsigned int t) {
+            size_t* local = &counts[(size_t)t * RADIX_BUCKETS];
+            for (size_t i = chunkBegin(n, t, numThreads); i < chunkBegin(n, t + 1, numThreads); ++i) {
+                uint32_t k = src[i];
+                dst[local[(k >> shift) & (RADIX_BUCKETS - 1)]++] = k;
+            }
+        });
+
+        std::swap(src, dst);
+    }
+    // 4 passes: the result is back in keys.
+}
+
+// Parallel sample sort: pick numThreads-1 splitters from a sorted sample,
+// partition every slice into buckets, then each thread std::sorts one bucket.
+// The sorted output ends up in tmp.
+static void sampleSort(std::vector<uint32_t>& keys, std::vector<uint32_t>& tmp, unsigned int numThreads) {
+    size_t n = keys.size();
+    if (numThreads <= 1 || n < (size_t)numThreads * SAMPLE_OVERSAMPLING) {
+        std::copy(keys.begin(), keys.end(), tmp.begin());
+        std::sort(tmp.begin(), tmp.end());
+        return;
+    }
+
+    size_t sampleCount = (size_t)numThreads * SAMPLE_OVERSAMPLING;
+    std::vector<uint32_t> sample(sampleCount);
+    for (size_t s = 0; s < sampleCount; ++s) {
+        sample[s] = keys[splitmix64(s) % n];
+    }
+    std::sort(sample.begin(), sample.end());
+
+    std::vector<uint32_t> splitters(numThreads - 1);
+    for (unsigned int b = 1; b < numThreads; ++b) {
+        splitters[b - 1] = sample[b * SAMPLE_OVERSAMPLING];
+    }
+
+    auto bucketOf = [&](uint32_t k) {
+        return (unsigned int)(std::upper_bound(splitters.begin(), splitters.end(), k) - splitters.begin());
+    };
+
+    // counts[t][b] -> output offset of thread t's keys in bucket b
+    std::vector<size_t> counts((size_t)numThreads * numThreads, 0);
+    parallelFor(numThreads, [&](unsigned int t) {
+        size_t* local = &counts[(size_t)t * numThreads];
+        for (size_t i = chunkBegin(n, t, numThreads); i < chunkBegin(n, t + 1, numThreads); ++i) {
+            local[bucketOf(keys[i])]++;
+        }
+    });
+
+    std::vector<size_t> bucketStart(numThreads + 1, 0);
+    size_t offset = 0;
+    for (unsigned int b = 0; b < numThreads; ++b) {
+        bucketStart[b] = offset;
+        for (unsigned int t = 0; t < numThreads; ++t) {
+            size_t c = counts[(size_t)t * numThreads + b];
+            counts[(size_t)t * numThreads + b] = offset;
+            offset += c;
+        }
+    }
+    bucketStart[numThreads] = offset;
+
+    parallelFor(numThreads, [&](unsigned int t) {
+        size_t* local = &counts[(size_t)t * numThreads];
+        for (size_t i = chunkBegin(n, t, numThreads); i < chunkBegin(n, t + 1, numThreads); ++i) {
+            uint32_t k = keys[i];
+            tmp[local[bucketOf(k)]++] = k;
+        }
+    });
+
+    parallelFor(numThreads, [&](unsigned int b) {
+        std::sort(tmp.begin() + bucketStart[b], tmp.begin() + bucketStart[b + 1]);
+    });
+}
+
+// =========================================================
+// HASH MAP
+// =========================================================
+
+// Open addressing, linear probing, power-of-two capacity.
+// Erase uses backward-shift deletion, so there are no tombstones and
+// miss lookups stay short after heavy erasing.
+class OpenAddressingMap {
+public:
+    static constexpr uint64_t EMPTY_KEY = ~0ull;
+
+    explicit OpenAddressingMap(size_t expectedKeys) {
+        size_t capacity = capacityFor(expectedKeys);
+        slots.assign(capacity, Slot{EMPTY_KEY, 0});
+        mask = capacity - 1;
+    }
+
+    static size_t bytesFor(size_t expectedKeys) { return capacityFor(expectedKeys) * sizeof(Slot); }
+
+    bool insert(uint64_t key, uint64_t value) {
+        size_t i = indexFor(key);
+        while (true) {
+            if (slots[i].key == EMPTY_KEY) {
+                slots[i] = Slot{key, value};
+                return true;
+            }
+            if (slots[i].key == key) {
+                slots[i].value = value;
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+    }
+
+    bool find(uint64_t key, uint64_t& value) const {
+        size_t i = indexFor(key);
+        while (true) {
+            if (slots[i].key == key) {
+                value = slots[i].value;
+                return true;
+            }
+            if (slots[i].key == EMPTY_KEY) return false;
+            i = (i + 1) & mask;
+        }
+    }
+
+    bool erase(uint64_t key) {
+        size_t i = indexFor(key);
+        while (true) {
+            if (slots[i].key == EMPTY_KEY) return false;
+            if (slots[i].key == key) break;
+            i = (i + 1) & mask;
+        }
+
+        // Shift later members of the probe run back into the hole.
+        size_t hole = i;
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (slots[j].key == EMPTY_KEY) break;
+            size_t home = indexFor(slots[j].key);
+            // Move j into the hole unless its home lies cyclically in (hole, j].
+            bool homeBetween = (hole <= j) ? (hole < home && home <= j)
+                                           : (hole < home || home <= j);
+            if (!homeBetween) {
+                slots[hole] = slots[j];
+                hole = j;
+            }
+        }
+        slots[hole].key = EMPTY_KEY;
+        return true;
+    }
+
+private:
+    struct Slot {
+        uint64_t key;
+        uint64_t value;
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+
+    static size_t capacityFor(size_t expectedKeys) {
+        size_t capacity = 16;
+        while (capacity < expectedKeys * 2) capacity <<= 1; // load factor <= 0.5
+        return capacity;
+    }
+
+    size_t indexFor(uint64_t key) const {
+        // Fibonacci hashing on top of a mixed key.
+        return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    }
+};
+
+// Inserted keys have the top bit clear, miss keys have it set,
+// so the two sets never intersect and EMPTY_KEY is never generated.
+static inline uint64_t hitKey(unsigned int t, size_t i) {
+    return splitmix64(((uint64_t)t << 40) | i) & ~(1ull << 63);
+}
+
+static inline uint64_t missKey(unsigned int t, size_t i) {
+    return (splitmix64(((uint64_t)t << 40) | i) | (1ull << 63)) & ~1ull;
+}
+
+// Whether lookup i of the mixed pass asks for a stored key. Random, so the
+// branch predictor cannot learn the hit/miss pattern.
+static inline bool mixedIsHit(size_t i) {
+    return splitmix64(~(uint64_t)i) % 100 < (uint64_t)MIXED_HIT_PERCENT;
+}
+
+// All per-thread tables together, the largest allocation of the hash phase.
+static size_t hashTableBytes(size_t keys, unsigned int numThreads) {
+    size_t bytes = 0;
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        bytes += OpenAddressingMap::bytesFor(chunkBegin(keys, t + 1, numThreads) - chunkBegin(keys, t, numThreads));
+    }
+    return bytes;
+}
+
+// =========================================================
+// SUITE
+// =========================================================
+
+DataStructureBenchmark::DataStructureBenchmark(const BenchmarkSizes& sizes)
+        : sortKeys(sizes.sortKeys), hashKeys(sizes.hashKeys), dsRepeats(sizes.dsRepeats) {}
+
+DataStructureBenchmark::DataStructureScores DataStructureBenchmark::runDataStructureSuite() {
+    LOGD("--- STARTING DATA STRUCTURE BENCHMARK ---");
+    verified = true;
+
+    unsigned int numCores = CpuInfo::coreCount();
+    const double sortMkeys = sortKeys / 1e6;
+    const double hashMkeys = hashKeys / 1e6;
+
+    DataStructureScores scores;
+
+    // Sort arrays are released before the hash tables are built.
+    {
+        std::vector<uint32_t> input(sortKeys);
+        for (int i = 0; i < sortKeys; ++i) {
+            input[i] = (uint32_t)splitmix64((uint64_t)i);
+        }
+
+        // std::sort output is the reference the other sorts must reproduce.
+        std::vector<uint32_t> reference;
+        scores.stdSortMkeys = sortMkeys / measureStdSort(input, reference);
+        LOGD("std::sort: %.2f Mkeys/s", scores.stdSortMkeys);
+
+        scores.radixSort = { sortMkeys / measureRadixSort(input, reference, 1),
+                             sortMkeys / measureRadixSort(input, reference, numCores) };
+        LOGD("Radix sort: %.2f / %.2f Mkeys/s", scores.radixSort.singleCoreMkeys, scores.radixSort.multiCoreMkeys);
+
+        scores.sampleSort = { sortMkeys / measureSampleSort(input, reference, 1),
+                              sortMkeys / measureSampleSort(input, reference, numCores) };
+        LOGD("Sample sort: %.2f / %.2f Mkeys/s", scores.sampleSort.singleCoreMkeys, scores.sampleSort.multiCoreMkeys);
+    }
+
+    HashTimings single = measureHashMap(1);
+    HashTimings multi = measureHashMap(numCores);
+    scores.hashInsert     = { hashMkeys / single.insertSec,     hashMkeys / multi.insertSec };
+    scores.hashLookupHit  = { hashMkeys / single.lookupHitSec,  hashMkeys / multi.lookupHitSec };
+    scores.hashLookupMiss = { hashMkeys / single.lookupMissSec, hashMkeys / multi.lookupMissSec };
+    scores.hashLookupMixed = { hashMkeys / single.lookupMixedSec, hashMkeys / multi.lookupMixedSec };
+    scores.hashErase      = { hashMkeys / single.eraseSec,      hashMkeys / multi.eraseSec };
+    LOGD("Hash insert: %.2f / %.2f, hit: %.2f / %.2f, miss: %.2f / %.2f, mixed: %.2f / %.2f, "
+         "erase: %.2f / %.2f Mkeys/s",
+         scores.hashInsert.singleCoreMkeys, scores.hashInsert.multiCoreMkeys,
+         scores.hashLookupHit.singleCoreMkeys, scores.hashLookupHit.multiCoreMkeys,
+         scores.hashLookupMiss.singleCoreMkeys, scores.hashLookupMiss.multiCoreMkeys,
+         scores.hashLookupMixed.singleCoreMkeys, scores.hashLookupMixed.multiCoreMkeys,
+         scores.hashErase.singleCoreMkeys, scores.hashErase.multiCoreMkeys);
+
+    scores.verified = verified;
+    if (!verified) LOGE("Data structure verification FAILED");
+    return scores;
+}
+
+double DataStructureBenchmark::measureStdSort(const std::vector<uint32_t>& input, std::vector<uint32_t>& sorted) {
+    double best = 0.0;
+    for (int rep = 0; rep < dsRepeats; ++rep) {
+        sorted = input;
+        double sec = timeSeconds([&]() { std::sort(sorted.begin(), sorted.end()); });
+        if (rep == 0 || sec < best) best = sec;
+    }
+    if (!std::is_sorted(sorted.begin(), sorted.end())) verified = false;
+    return std::max(best, 1e-9);
+}
+
+double DataStructureBenchmark::measureRadixSort(const std::vector<uint32_t>& input,
+                                                const std::vector<uint32_t>& reference, unsigned int numThreads) {
+    double best = 0.0;
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> tmp(input.size());
+    for (int rep = 0; rep < dsRepeats; ++rep) {
+        keys = input;
+        double sec = timeSeconds([&]() { radixSort(keys, tmp, numThreads); });
+        if (rep == 0 || sec < best) best = sec;
+    }
+    if (keys != reference) verified = false;
+    return std::max(best, 1e-9);
+}
+
+double DataStructureBenchmark::measureSampleSort(const std::vector<uint32_t>& input,
+                                                 const std::vector<uint32_t>& reference, unsigned int numThreads) {
+    double best = 0.0;
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> sorted(input.size());
+    for (int rep = 0; rep < dsRepeats; ++rep) {
+        keys = input;
+        double sec = timeSeconds([&]() { sampleSort(keys, sorted, numThreads); });
+        if (rep == 0 || sec < best) best = sec;
+    }
+    if (sorted != reference) verified = false;
+    return std::max(best, 1e-9);
+}
+
+// Each thread owns a private table holding hashKeys / numThreads keys
+// (shared-nothing), so the multi-core number reflects memory-system scaling
+// rather than lock contention.
+DataStructureBenchmark::HashTimings DataStructureBenchmark::measureHashMap(unsigned int numThreads) {
+    std::vector<OpenAddressingMap> maps;
+    maps.reserve(numThreads);
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        maps.emplace_back(chunkBegin(hashKeys, t + 1, numThreads) - chunkBegin(hashKeys, t, numThreads));
+    }
+    std::vector<size_t> hits(numThreads, 0);
+    std::vector<size_t> misses(numThreads, 0);
+    std::vector<size_t> mixedFound(numThreads, 0);
+    std::vector<size_t> mixedExpected(numThreads, 0);
+    std::vector<size_t> erased(numThreads, 0);
+
+    auto keyCount = [&](unsigned int t) {
+        return chunkBegin(hashKeys, t + 1, numThreads) - chunkBegin(hashKeys, t, numThreads);
+    };
+
+    HashTimings timings;
+
+    timings.insertSec = timeSeconds([&]() {
+        parallelFor(numThreads, [&](unsigned int t) {
+            size_t n = keyCount(t);
+            for (size_t i = 0; i < n; ++i) maps[t].insert(hitKey(t, i), i);
+        });
+    });
+
+    timings.lookupHitSec = timeSeconds([&]() {
+        parallelFor(numThreads, [&](unsigned int t) {
+            size_t n = keyCount(t);
+            size_t found = 0;
+            uint64_t value = 0;
+            // Walk the keys in a different order than they were inserted.
+            for (size_t i = 0; i < n; ++i) {
+                size_t k = (size_t)(((uint64_t)i * 7919) % n);
+                if (maps[t].find(hitKey(t, k), value) && value == k) found++;
+            }
+            hits[t] = found;
+        });
+    });
+
+    timings.lookupMissSec = timeSeconds([&]() {
+        parallelFor(numThreads, [&](unsigned int t) {
+            size_t n = keyCount(t);
+            size_t found = 0;
+            uint64_t value = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (maps[t].find(missKey(t, i), value)) found++;
+            }
+            misses[t] = found;
+        });
+    });
+
+    timings.lookupMixedSec = timeSeconds([&]() {
+        parallelFor(numThreads, [&](unsigned int t) {
+            size_t n = keyCount(t);
+            size_t found = 0;
+            size_t expected = 0;
+            uint64_t value = 0;
+            for (size_t i = 0; i < n; ++i) {
+                bool hit = mixedIsHit(i);
+                size_t k = (size_t)(((uint64_t)i * 7919) % n);
+                expected += hit;
+                if (maps[t].find(hit ? hitKey(t, k) : missKey(t, i), value)) found++;
+            }
+            mixedFound[t] = found;
+            mixedExpected[t] = expected;
+        });
+    });
+
+    timings.eraseSec = timeSeconds([&]() {
+        parallelFor(numThreads, [&](unsigned int t) {
+            size_t n = keyCount(t);
+            size_t count = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (maps[t].erase(hitKey(t, i))) count++;
+            }
+            erased[t] = count;
+        });
+    });
+
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        size_t n = keyCount(t);
+        uint64_t value = 0;
+        if (hits[t] != n || misses[t] != 0 || mixedFound[t] != mixedExpected[t] || erased[t] != n ||
+            maps[t].find(hitKey(t, 0), value)) {
+            verified = false;
+        }
+    }
+
+    timings.insertSec = std::max(timings.insertSec, 1e-9);
+    timings.lookupHitSec = std::max(timings.lookupHitSec, 1e-9);
+    timings.lookupMissSec = std::max(timings.lookupMissSec, 1e-9);
+    timings.lookupMixedSec = std::max(timings.lookupMixedSec, 1e-9);
+    timings.eraseSec = std::max(timings.eraseSec, 1e-9);
+    return timings;
+}
+
+size_t DataStructureBenchmark::workingSetBytes() const {
+    // Sorting and hashing never overlap; the tables are split per thread,
+    // so count the larger of the one-table and all-cores layouts.
+    size_t sortBytes = 4 * (size_t)sortKeys * sizeof(uint32_t); // input, reference, keys, scratch
+    size_t hashBytes = std::max(hashTableBytes(hashKeys, 1), hashTableBytes(hashKeys, CpuInfo::coreCount()));
+    return std::max(sortBytes, hashBytes);
+}
+
+// =========================================================
+// REGISTRATION
+// =========================================================
+
+// {"single":x, "multi":y} in Mkeys/s
+static std::string throughputToJson(const DataStructureBenchmark::Throughput& t) {
+    std::stringstream ss;
+    ss << "{\"single\":" << t.singleCoreMkeys << ", \"multi\":" << t.multiCoreMkeys << "}";
+    return ss.str();
+}
+
+class DataStructureKernel : public BenchmarkKernel {
+public:
+    void setup(const BenchmarkSizes& sizes) override {
+        ds.reset(new DataStructureBenchmark(sizes));
+        workingSet = ds->workingSetBytes();
+    }
+    void run() override { scores = ds->runDataStructureSuite(); }
+    bool verify() override { return scores.verified; }
+    void teardown() override { ds.reset(); }
+    double score() const override { return scores.radixSort.multiCoreMkeys; }
+    size_t workingSetBytes() const override { return workingSet; }
+    static size_t workingSetHint(const BenchmarkSizes& sizes) { return DataStructureBenchmark(sizes).workingSetBytes(); }
+    void writeJson(std::ostream& out) const override {
+        out << "\"dataStructures\":{";
+        out << "\"verified\":" << (scores.verified ? "true" : "false") << ", ";
+        out << "\"stdSort\":" << scores.stdSortMkeys << ", ";
+        out << "\"radixSort\":" << throughputToJson(scores.radixSort) << ", ";
+        out << "\"sampleSort\":" << throughputToJson(scores.sampleSort) << ", ";
+        out << "\"hashInsert\":" << throughputToJson(scores.hashInsert) << ", ";
+        out << "\"hashLookupHit\":" << throughputToJson(scores.hashLookupHit) << ", ";
+        out << "\"hashLookupMiss\":" << throughputToJson(scores.hashLookupMiss) << ", ";
+        out << "\"hashLookupMixed\":" << throughputToJson(scores.hashLookupMixed) << ", ";
+        out << "\"hashErase\":" << throughputToJson(scores.hashErase);
+        out << "}";
+    }
+
+private:
+    std::unique_ptr<DataStructureBenchmark> ds;
+    DataStructureBenchmark::DataStructureScores scores = {};
+    size_t workingSet = 0;
+};
+
+static KernelRegistration<DataStructureKernel> registration(
+        "data_structures", "ds", {"single_core", "multi_core", "integer", "memory_bound"}, 0, 0.0, 50);
@@ -0,0 +1,65 @@
+//
+// Created by Marius on 18/10/2026.
+//
+
+#ifndef PERFORMIC_DATASTRUCTUREBENCHMARK_H
+#define PERFORMIC_DATASTRUCTUREBENCHMARK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "BenchmarkSizes.h"
+
+// Irregular-access workloads: sorting and hashing.
+// Unlike the dense kernels in CpuBenchmark these are dominated by
+// data-dependent branches, scattered stores and cache/TLB misses.
+class DataStructureBenchmark {
+public:
+    struct Throughput {
+        double singleCoreMkeys;
+        double multiCoreMkeys;
+    };
+
+    struct DataStructureScores {
+        double stdSortMkeys;      // single-threaded std::sort baseline
+        Throughput radixSort;     // LSD radix, 8-bit digits
+        Throughput sampleSort;    // parallel sample sort (std::sort per bucket)
+        Throughput hashInsert;
+        Throughput hashLookupHit;
+        Throughput hashLookupMiss;
+        Throughput hashLookupMixed;  // 75% hits, 25% misses, in random order
+        Throughput hashErase;
+        bool verified;            // every sort equal to std::sort, every lookup answered correctly
+    };
+
+    explicit DataStructureBenchmark(const BenchmarkSizes& sizes);
+
+    DataStructureScores runDataStructureSuite();
+
+    size_t workingSetBytes() const;
+
+private:
+    int sortKeys;
+    int hashKeys;
+    int dsRepeats;
+
+    // Wall time of each hash-map phase, all threads together.
+    struct HashTimings {
+        double insertSec;
+        double lookupHitSec;
+        double lookupMissSec;
+        double lookupMixedSec;
+        double eraseSec;
+    };
+
+    bool verified = true;
+
+    double measureStdSort(const std::vector<uint32_t>& input, std::vector<uint32_t>& sorted);
+    double measureRadixSort(const std::vector<uint32_t>& input, const std::vector<uint32_t>& reference,
+                            unsigned int numThreads);
+    double measureSampleSort(const std::vector<uint32_t>& input, const std::vector<uint32_t>& reference,
+                             unsigned int numThreads);
+    HashTimings measureHashMap(unsigned int numThreads);
+};
+
+#endif //PERFORMIC_DATASTRUCTUREBENCHMARK_H
@@ -0,0 +1,361 @@
+#include "FpPeakBenchmark.h"
+#include "utils.h"
+#include "CpuInfo.h"
+#include "BenchmarkRegistry.h"
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <thread>
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <android/log.h>
+
+#define LOG_TAG "PerformicFP"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+
+// --- CONFIGURATION ---
+// Independent accumulator chains per kernel. Needs to cover
+// (FMA latency x FMA pipes) so the pipes never wait on a previous result.
+// AArch64 has 32 SIMD registers, x86 only 16 XMM.
+#if defined(__aarch64__)
+constexpr int FMA_CHAINS = 16;
+constexpr int MAC_CHAINS = 12; // integer MACs also need one live operand per chain
+#else
+constexpr int FMA_CHAINS = 10;
+constexpr int MAC_CHAINS = 6;
+#endif
+
+// Empty asm that pins a value to a register and makes it opaque to the optimizer.
+// It stops the compiler from re-vectorizing the scalar chains or hoisting
+// loop-invariant multiplies, without emitting any instruction.
+#if defined(__aarch64__) || defined(__arm__)
+#define KEEP_IN_FP_REGISTER(x) asm volatile("" : "+w"(x))
+#elif defined(__x86_64__) || defined(__i386__)
+#define KEEP_IN_FP_REGISTER(x) asm volatile("" : "+x"(x))
+#else
+#define KEEP_IN_FP_REGISTER(x) asm volatile("" : "+m"(x))
+#endif
+#define KEEP_IN_INT_REGISTER(x) asm volatile("" : "+r"(x))
+
+// The chain loops must be unrolled for the accumulators to live in
+// registers; GCC does not do it on its own at -O2.
+#if defined(__clang__)
+#define UNROLL_FULL _Pragma("unroll")
+#else
+#define UNROLL_FULL _Pragma("GCC unroll 16")
+#endif
+
+typedef float    f32x4 __attribute__((vector_size(16)));
+typedef double   f64x2 __attribute__((vector_size(16)));
+typedef uint16_t u16x8 __attribute__((vector_size(16)));
+
+// Sums every lane of a scalar or vector value into a double checksum.
+template <typename V, typename E>
+static inline double reduceLanes(const V& v) {
+    E lanes[sizeof(V) / sizeof(E)];
+    std::memcpy(lanes, &v, sizeof(V));
+    double total = 0.0;
+    for (E lane : lanes) total += (double)lane;
+    return total;
+}
+
+// acc = acc * mul + add on FMA_CHAINS independent accumulators.
+// mul < 1 keeps every chain converging to a finite value (no inf/denormal slow paths).
+// Always inlined so the fp16 wrappers' target attribute applies to the loop body.
+template <typename V, typename E>
+__attribute__((always_inline)) static inline double fmaChains(long iterations) {
+    V acc[FMA_CHAINS];
+    V mul = V{} + (E)0.999;
+    V add = V{} + (E)0.001;
+    for (int c = 0; c < FMA_CHAINS; ++c) acc[c] = V{} + (E)(c + 1);
+
+    for (long i = 0; i < iterations; ++i) {
+        UNROLL_FULL
+        for (int c = 0; c < FMA_CHAINS; ++c) {
+            acc[c] = acc[c] * mul + add;
+            KEEP_IN_FP_REGISTER(acc[c]);
+        }
+    }
+
+    V sum = acc[0];
+    for (int c = 1; c < FMA_CHAINS; ++c) sum += acc[c];
+    return reduceLanes<V, E>(sum);
+}
+
+static double fp32Scalar(long iterations) { return fmaChains<float, float>(iterations); }
+static double fp32Vector(long iterations) { return fmaChains<f32x4, float>(iterations); }
+static double fp64Scalar(long iterations) { return fmaChains<double, double>(iterations); }
+static double fp64Vector(long iterations) { return fmaChains<f64x2, double>(iterations); }
+
+#if defined(__aarch64__)
+// ARMv8.2 FP16 arithmetic is optional, so these are compiled for it but only
+// called when HWCAP_ASIMDHP is set.
+typedef _Float16 f16x8 __attribute__((vector_size(16)));
+#define FP16_TARGET __attribute__((target("arch=armv8.2-a+fp16")))
+
+FP16_TARGET static double fp16Scalar(long iterations) { return fmaChains<_Float16, _Float16>(iterations); }
+FP16_TARGET static double fp16Vector(long iterations) { return fmaChains<f16x8, _Float16>(iterations); }
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+// The x86 ABIs predate FMA3, so the generic kernels above issue a separate
+// multiply and add. These are picked at runtime when the CPU has FMA3.
+#define FMA_TARGET __attribute__((target("avx2,fma")))
+
+FMA_TARGET static double fp32ScalarFma(long iterations) { return fmaChains<float, float>(iterations); }
+FMA_TARGET static double fp32VectorFma(long iterations) { return fmaChains<f32x4, float>(iterations); }
+FMA_TARGET static double fp64ScalarFma(long iterations) { return fmaChains<double, double>(iterations); }
+FMA_TARGET static double fp64VectorFma(long iterations) { return fmaChains<f64x2, double>(iterations); }
+#endif
+
+// Scalar int32 multiply-accumulate on int8-range operands (one MAC per
+// instruction, no packed int8 dot): what a scalar int8 inference loop runs on.
+// The operands are re-hidden every iteration so x * y cannot be hoisted.
+static double int32MacScalar(long iterations) {
+    uint32_t acc[MAC_CHAINS];
+    int32_t x[MAC_CHAINS];
+    int32_t y = -7;
+    for (int c = 0; c < MAC_CHAINS; ++c) {
+        acc[c] = (uint32_t)c;
+        x[c] = (int8_t)(c * 11 - 60);
+    }
+
+    for (long i = 0; i < iterations; ++i) {
+        KEEP_IN_INT_REGISTER(y);
+        for (int c = 0; c < MAC_CHAINS; ++c) {
+            KEEP_IN_INT_REGISTER(x[c]);
+            acc[c] += (uint32_t)(x[c] * y);
+        }
+    }
+
+    uint32_t sum = 0;
+    for (int c = 0; c < MAC_CHAINS; ++c) sum += acc[c];
+    return (double)sum;
+}
+
+#if defined(__aarch64__)
+typedef int32_t i32x4 __attribute__((vector_size(16)));
+typedef int8_t  i8x16 __attribute__((vector_size(16)));
+
+// SDOT: 16 int8 x int8 products summed into 4 int32 lanes per instruction.
+// Emitted through asm so it does not depend on the NDK's default -march.
+static double int8DotVector(long iterations) {
+    i32x4 acc[FMA_CHAINS];
+    i8x16 x, y;
+    for (int l = 0; l < 16; ++l) {
+        x[l] = (int8_t)(l * 7 - 50);
+        y[l] = (int8_t)(33 - l * 5);
+    }
+    for (int c = 0; c < FMA_CHAINS; ++c) acc[c] = i32x4{} + c;
+
+    for (long i = 0; i < iterations; ++i) {
+        for (int c = 0; c < FMA_CHAINS; ++c) {
+            asm(".arch_extension dotprod\n\t"
+                "sdot %0.4s, %1.16b, %2.16b"
+                : "+w"(acc[c])
+                : "w"(x), "w"(y));
+        }
+    }
+
+    i32x4 sum = acc[0];
+    for (int c = 1; c < FMA_CHAINS; ++c) sum += acc[c];
+    return reduceLanes<i32x4, int32_t>(sum);
+}
+#endif
+
+// Pre-dotprod SIMD path: int8 values widened to 16-bit lanes, multiply-accumulate
+// (SMLA / PMULLW+PADDW). Unsigned lanes give the same bits without signed overflow.
+static double int8DotWidened(long iterations) {
+    u16x8 acc[MAC_CHAINS];
+    u16x8 x[MAC_CHAINS];
+    u16x8 y = u16x8{} + (uint16_t)(int16_t)-7;
+    for (int c = 0; c < MAC_CHAINS; ++c) {
+        acc[c] = u16x8{} + (uint16_t)c;
+        x[c] = u16x8{} + (uint16_t)(int16_t)(int8_t)(c * 11 - 60);
+    }
+
+    for (long i = 0; i < iterations; ++i) {
+        KEEP_IN_FP_REGISTER(y);
+        for (int c = 0; c < MAC_CHAINS; ++c) {
+            KEEP_IN_FP_REGISTER(x[c]);
+            acc[c] += x[c] * y;
+        }
+    }
+
+    u16x8 sum = acc[0];
+    for (int c = 1; c < MAC_CHAINS; ++c) sum += acc[c];
+    return reduceLanes<u16x8, uint16_t>(sum);
+}
+
+FpPeakBenchmark::FpPeakBenchmark(const BenchmarkSizes& sizes)
+        : peakIterations(sizes.peakIterations), peakRepeats(sizes.peakRepeats) {}
+
+FpPeakBenchmark::PeakScores FpPeakBenchmark::runPeakSuite() {
+    LOGD("--- STARTING PEAK FLOPS BENCHMARK ---");
+
+    const CpuInfo::Features& isa = CpuInfo::features();
+    unsigned int numCores = CpuInfo::coreCount();
+    std::vector<double> coreFreqs = CpuInfo::coreMaxFrequenciesGHz();
+    double maxFreq = CpuInfo::maxFrequencyGHz();
+    double sumFreq = std::accumulate(coreFreqs.begin(), coreFreqs.end(), 0.0);
+
+    struct Kernel {
+        const char* name;
+        KernelFn fn;             // nullptr when not available on this build/device
+        double opsPerIteration;
+        double opsPerCycle;      // theoretical issue rate for one core
+    };
+
+    // 2 ops per FMA/MAC; one scalar integer multiplier per core.
+    // Kernels with fn == nullptr are reported as unsupported.
+    std::vector<Kernel> kernels;
+#if defined(__aarch64__)
+    kernels.push_back({"fp16_scalar", isa.asimdhp ? fp16Scalar : nullptr, FMA_CHAINS * 2.0,     FMA_PIPES * 2.0});
+    kernels.push_back({"fp16_vector", isa.asimdhp ? fp16Vector : nullptr, FMA_CHAINS * 8 * 2.0, FMA_PIPES * 8 * 2.0});
+#else
+    kernels.push_back({"fp16_scalar", nullptr, 0.0, 0.0});
+    kernels.push_back({"fp16_vector", nullptr, 0.0, 0.0});
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+    // Without FMA3 every pipe retires a multiply or an add, one op per lane.
+    const bool fma = isa.avx2 && isa.fma;
+    const double fmaOps = fma ? 2.0 : 1.0;
+    kernels.push_back({"fp32_scalar", fma ? fp32ScalarFma : fp32Scalar, FMA_CHAINS * 2.0,     FMA_PIPES * fmaOps});
+    kernels.push_back({"fp32_vector", fma ? fp32VectorFma : fp32Vector, FMA_CHAINS * 4 * 2.0, FMA_PIPES * 4 * fmaOps});
+    kernels.push_back({"fp64_scalar", fma ? fp64ScalarFma : fp64Scalar, FMA_CHAINS * 2.0,     FMA_PIPES * fmaOps});
+    kernels.push_back({"fp64_vector", fma ? fp64VectorFma : fp64Vector, FMA_CHAINS * 2 * 2.0, FMA_PIPES * 2 * fmaOps});
+#else
+    kernels.push_back({"fp32_scalar", fp32Scalar, FMA_CHAINS * 2.0,     FMA_PIPES * 2.0});
+    kernels.push_back({"fp32_vector", fp32Vector, FMA_CHAINS * 4 * 2.0, FMA_PIPES * 4 * 2.0});
+    kernels.push_back({"fp64_scalar", fp64Scalar, FMA_CHAINS * 2.0,     FMA_PIPES * 2.0});
+    kernels.push_back({"fp64_vector", fp64Vector, FMA_CHAINS * 2 * 2.0, FMA_PIPES * 2 * 2.0});
+#endif
+    kernels.push_back({"int32_mac_scalar", int32MacScalar, MAC_CHAINS * 2.0, 2.0});
+#if defined(__aarch64__)
+    if (isa.dotprod) {
+        kernels.push_back({"int8_dot_vector", int8DotVector, FMA_CHAINS * 16 * 2.0, FMA_PIPES * 16 * 2.0});
+    } else {
+        kernels.push_back({"int8_dot_vector", int8DotWidened, MAC_CHAINS * 8 * 2.0, FMA_PIPES * 8 * 2.0});
+    }
+#else
+    kernels.push_back({"int8_dot_vector", int8DotWidened, MAC_CHAINS * 8 * 2.0, FMA_PIPES * 8 * 2.0});
+#endif
+
+    PeakScores scores;
+    scores.maxFrequencyGHz = maxFreq;
+
+    for (const Kernel& k : kernels) {
+        PeakResult r = {k.name, k.fn != nullptr, 0.0, 0.0, 0.0, 0.0};
+
+        if (k.fn != nullptr) {
+            // Warm-up: lets the governor ramp the core before timing.
+            DoNotOptimize(k.fn(peakIterations / 4));
+
+            double totalOps = k.opsPerIteration * (double)peakIterations;
+            double singleSec = measureSingleCore(k.fn);
+            double multiSec = measureMultiCore(k.fn, numCores);
+
+            r.singleCoreGops = totalOps / 1e9 / std::max(singleSec, 1e-9);
+            r.multiCoreGops = totalOps * numCores / 1e9 / std::max(multiSec, 1e-9);
+            r.singleCorePeak = maxFreq * k.opsPerCycle;
+            r.multiCorePeak = sumFreq * k.opsPerCycle;
+        }
+
+        LOGD("%s: %.2f / %.2f G(FL)OPS single, %.2f / %.2f multi",
+             k.name, r.singleCoreGops, r.singleCorePeak, r.multiCoreGops, r.multiCorePeak);
+        scores.kernels.push_back(r);
+    }
+
+    return scores;
+}
+
+double FpPeakBenchmark::measureSingleCore(KernelFn fn) {
+    double best = 0.0;
+    for (int rep = 0; rep < peakRepeats; ++rep) {
+        auto start = std::chrono::high_resolution_clock::now();
+        double res = fn(peakIterations);
+        DoNotOptimize(res);
+        auto end = std::chrono::high_resolution_clock::now();
+        double sec = std::chrono::duration<double>(end - start).count();
+        if (rep == 0 || sec < best) best = sec;
+    }
+    return best;
+}
+
+double FpPeakBenchmark::measureMultiCore(KernelFn fn, unsigned int numCores) {
+    double best = 0.0;
+    for (int rep = 0; rep < peakRepeats; ++rep) {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        std::vector<std::thread> threads;
+        threads.reserve(numCores);
+        for (unsigned int i = 0; i < numCores; ++i) {
+            long iterations = peakIterations;
+            threads.emplace_back([fn, iterations]() {
+                double res = fn(iterations);
+                DoNotOptimize(res);
+            });
+        }
+        for (auto& t : threads) { if (t.joinable()) t.join(); }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        double sec = std::chrono::duration<double>(end - start).count();
+        if (rep == 0 || sec < best) best = sec;
+    }
+    return best;
+}
+
+// =========================================================
+// REGISTRATION
+// =========================================================
+
+// One peak-throughput kernel and its theoretical ceiling.
+static std::string peakResultToJson(const FpPeakBenchmark::PeakResult& k) {
+    std::stringstream ss;
+    ss << "{";
+    ss << "\"name\":\"" << k.name << "\", ";
+    ss << "\"supported\":" << (k.supported ? "true" : "false") << ", ";
+    ss << "\"singleCoreGops\":" << k.singleCoreGops << ", ";
+    ss << "\"multiCoreGops\":" << k.multiCoreGops << ", ";
+    ss << "\"singleCorePeak\":" << k.singleCorePeak << ", ";
+    ss << "\"multiCorePeak\":" << k.multiCorePeak;
+    ss << "}";
+    return ss.str();
+}
+
+class FpPeakKernel : public BenchmarkKernel {
+public:
+    void setup(const BenchmarkSizes& sizes) override {
+        peak.reset(new FpPeakBenchmark(sizes));
+        workingSet = peak->workingSetBytes();
+    }
+    void run() override { scores = peak->runPeakSuite(); }
+    bool verify() override { return fp32VectorGops() > 0.0; }
+    void teardown() override { peak.reset(); }
+    // fp32 vector GFLOPS on all cores, the usual roofline ceiling.
+    double score() const override { return fp32VectorGops(); }
+    // Sub-kernels differ in op type and thread count; there is no common unit.
+    int iterations() const override { return 0; }
+    size_t workingSetBytes() const override { return workingSet; }
+    static size_t workingSetHint(const BenchmarkSizes& sizes) { return FpPeakBenchmark(sizes).workingSetBytes(); }
+    void writeJson(std::ostream& out) const override {
+        out << "\"maxFrequencyGHz\":" << scores.maxFrequencyGHz << ", ";
+        out << "\"fpPeak\":" << jsonArray(scores.kernels, peakResultToJson);
+    }
+
+private:
+    std::unique_ptr<FpPeakBenchmark> peak;
+    FpPeakBenchmark::PeakScores scores = {};
+    size_t workingSet = 0;
+
+    double fp32VectorGops() const {
+        for (const FpPeakBenchmark::PeakResult& k : scores.kernels) {
+            if (k.name == "fp32_vector") return k.multiCoreGops;
+        }
+        return 0.0;
+    }
+};
+
+static KernelRegistration<FpPeakKernel> registration(
+        "fp_peak", "fp", {"single_core", "multi_core", "compute", "simd"}, 0, 0.0, 40);
@@ -0,0 +1,52 @@
+//
+// Created by Marius on 18/10/2026.
+//
+
+#ifndef PERFORMIC_FPPEAKBENCHMARK_H
+#define PERFORMIC_FPPEAKBENCHMARK_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "BenchmarkSizes.h"
+
+// Peak arithmetic throughput (the roofline compute ceiling).
+// Every kernel keeps several independent FMA chains in flight so the
+// measured rate is bound by issue width, not by FMA latency.
+class FpPeakBenchmark {
+public:
+    struct PeakResult {
+        std::string name;        // e.g. "fp32_vector"
+        bool supported;          // false when the ISA path is missing on this device
+        double singleCoreGops;   // GFLOPS for fp kernels, GOPS for integer kernels
+        double multiCoreGops;
+        double singleCorePeak;   // theoretical, from detected max frequency (0 if unknown)
+        double multiCorePeak;
+    };
+
+    struct PeakScores {
+        double maxFrequencyGHz;
+        std::vector<PeakResult> kernels;
+    };
+
+    explicit FpPeakBenchmark(const BenchmarkSizes& sizes);
+
+    PeakScores runPeakSuite();
+
+    size_t workingSetBytes() const { return 0; } // register-resident
+
+private:
+    long peakIterations;
+    int peakRepeats;
+
+    // Assumed FP/SIMD pipes per core when deriving the theoretical peak.
+    // Matches current Cortex-A7x class cores; little cores report <100%.
+    static constexpr int FMA_PIPES = 2;
+
+    typedef double (*KernelFn)(long iterations);
+
+    double measureSingleCore(KernelFn fn);
+    double measureMultiCore(KernelFn fn, unsigned int numCores);
+};
+
+#endif //PERFORMIC_FPPEAKBENCHMARK_H
@@ -0,0 +1,739 @@
+#include "ImagePipelineBenchmark.h"
+#include "utils.h"
+#include "CpuInfo.h"
+#include "BenchmarkRegistry.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <sstream>
+#include <android/log.h>
+
+#define LOG_TAG "PerformicImage"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+// --- CONFIGURATION ---
+constexpr int TILE_ROWS = 64;        // stage-by-stage: frame rows per tile
+constexpr int FUSED_TILE_ROWS = 16;  // fused: output rows per tile (~33 frame rows)
+constexpr int RING_SLOTS = 8;        // line-buffer depth, >= 5 taps of the vertical blur
+
+#define SIMD_INLINE static inline __attribute__((always_inline))
+
+// The reference must stay scalar, otherwise the speedup column is meaningless.
+// Clang takes a loop pragma; GCC only honours a per-function option.
+#if defined(__clang__)
+#define SCALAR_LOOP _Pragma("clang loop vectorize(disable) interleave(disable)")
+#define SCALAR_ROW
+#else
+#define SCALAR_LOOP
+#define SCALAR_ROW __attribute__((optimize("no-tree-vectorize")))
+#endif
+
+// =========================================================
+// PER-PIXEL REFERENCE
+// =========================================================
+// All stages are pure integer math so the SIMD rows can be checked bit-exact.
+
+static inline int clampIndex(int i, int n) {
+    return i < 0 ? 0 : (i >= n ? n - 1 : i);
+}
+
+static inline uint8_t clampU8(int v) {
+    return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// BT.601 limited range, 8.8 fixed point.
+static inline void yuvToRgbPixel(int y, int u, int v, uint8_t* r, uint8_t* g, uint8_t* b) {
+    int c = 298 * (y - 16) + 128;
+    *r = clampU8((c + 409 * (v - 128)) >> 8);
+    *g = clampU8((c - 100 * (u - 128) - 208 * (v - 128)) >> 8);
+    *b = clampU8((c + 516 * (u - 128)) >> 8);
+}
+
+// [1 4 6 4 1] without normalization; the vertical pass divides by 256 once.
+static inline uint16_t hblurPixel(const uint8_t* s, int x, int w) {
+    return (uint16_t)(s[clampIndex(x - 2, w)] + 4 * s[clampIndex(x - 1, w)] + 6 * s[x] +
+                      4 * s[clampIndex(x + 1, w)] + s[clampIndex(x + 2, w)]);
+}
+
+static inline uint8_t vblurPixel(const uint16_t* const* rows, int x) {
+    return (uint8_t)((rows[0][x] + 4 * rows[1][x] + 6 * rows[2][x] + 4 * rows[3][x] + rows[4][x] + 128) >> 8);
+}
+
+static inline uint8_t grayPixel(int r, int g, int b) {
+    return (uint8_t)((77 * r + 150 * g + 29 * b + 128) >> 8);
+}
+
+// |Gx| + |Gy|, saturated to 255.
+static inline uint8_t sobelPixel(const uint8_t* a, const uint8_t* c, const uint8_t* b, int x, int w) {
+    int xl = clampIndex(x - 1, w);
+    int xr = clampIndex(x + 1, w);
+    int gx = (a[xr] + 2 * c[xr] + b[xr]) - (a[xl] + 2 * c[xl] + b[xl]);
+    int gy = (b[xl] + 2 * b[x] + b[xr]) - (a[xl] + 2 * a[x] + a[xr]);
+    int m = std::abs(gx) + std::abs(gy);
+    return (uint8_t)(m > 255 ? 255 : m);
+}
+
+static inline uint8_t vresizePixel(uint32_t h0, uint32_t h1, int fy) {
+    return (uint8_t)((h0 * (uint32_t)(256 - fy) + h1 * (uint32_t)fy + 32768) >> 16);
+}
+
+// =========================================================
+// ROW KERNELS
+// =========================================================
+
+struct RowKernels {
+    void (*yuvToRgb)(const uint8_t* yRow, const uint8_t* vuRow, uint8_t* r, uint8_t* g, uint8_t* b, int w);
+    void (*hblur)(const uint8_t* src, uint16_t* dst, int w);
+    void (*vblur)(const uint16_t* const* rows, uint8_t* dst, int w);
+    void (*gray)(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, int w);
+    void (*sobel)(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int w);
+    void (*vresize)(const uint16_t* h0, const uint16_t* h1, int fy, uint8_t* dst, int w);
+};
+
+// ---- Scalar reference ----
+
+SCALAR_ROW static void yuvToRgbRowScalar(const uint8_t* yRow, const uint8_t* vuRow, uint8_t* r, uint8_t* g, uint8_t* b, int w) {
+    SCALAR_LOOP
+    for (int x = 0; x < w; ++x) {
+        // NV21: V then U for every 2x2 block.
+        yuvToRgbPixel(yRow[x], vuRow[x | 1], vuRow[x & ~1], r + x, g + x, b + x);
+    }
+}
+
+SCALAR_ROW static void hblurRowScalar(const uint8_t* src, uint16_t* dst, int w) {
+    SCALAR_LOOP
+    for (int x = 0; x < w; ++x) dst[x] = hblurPixel(src, x, w);
+}
+
+SCALAR_ROW static void vblurRowScalar(const uint16_t* const* rows, uint8_t* dst, int w) {
+    SCALAR_LOOP
+    for (int x = 0; x < w; ++x) dst[x] = vblurPixel(rows, x);
+}
+
+SCALAR_ROW static void grayRowScalar(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, int w) {
+    SCALAR_LOOP
+    for (int x = 0; x < w; ++x) dst[x] = grayPixel(r[x], g[x], b[x]);
+}
+
+SCALAR_ROW static void sobelRowScalar(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dst, int w) {
+    SCALAR_LOOP
+    for (int x = 0; x < w; ++x) dst[x] = sobelPixel(above, row, below, x, w);
+}
+
+SCALAR_ROW static void vresizeRowScalar(const uint16_t* h0, const uint16_t* h1, int fy, uint8_t* dst, int w) {
+    SCALAR_LOOP
+    for (int x = 0; x < w; ++x) dst[x] = vresizePixel(h0[x], h1[x], fy);
+}
+
+static const RowKernels scalarKernels = {
+    yuvToRgbRowScalar, hblurRowScalar, vblurRowScalar, grayRowScalar, sobelRowScalar, vresizeRowScalar
+};
+
+// ---- SIMD (GCC/Clang vector extensions -> NEON / SSE2 / AVX2) ----
+// Each row kernel is a template over a width trait, N pixels per step.
+// Everything runs in 16-bit lanes (8 per 128-bit register); the constants
+// are split so no step can overflow. Edges fall back to the per-pixel
+// reference.
+
+struct Simd128 {
+    static constexpr int N = 8;
+    typedef uint8_t  u8  __attribute__((vector_size(8)));
+    typedef uint16_t u16 __attribute__((vector_size(16)));
+    typedef int16_t  i16 __attribute__((vector_size(16)));
+
+    // NV21 chroma pairs (V0 U0 V1 U1 ...) expanded to one value per pixel.
+    SIMD_INLINE u8 dupEven(u8 v) { return __builtin_shufflevector(v, v, 0, 0, 2, 2, 4, 4, 6, 6); }
+    SIMD_INLINE u8 dupOdd(u8 v)  { return __builtin_shufflevector(v, v, 1, 1, 3, 3, 5, 5, 7, 7); }
+};
+
+struct Simd256 {
+    static constexpr int N = 16;
+    typedef uint8_t  u8  __attribute__((vector_size(16)));
+    typedef uint16_t u16 __attribute__((vector_size(32)));
+    typedef int16_t  i16 __attribute__((vector_size(32)));
+
+    SIMD_INLINE u8 dupEven(u8 v) {
+        return __builtin_shufflevector(v, v, 0, 0, 2, 2, 4, 4, 6, 6, 8, 8, 10, 10, 12, 12, 14, 14);
+    }
+    SIMD_INLINE u8 dupOdd(u8 v) {
+        return __builtin_shufflevector(v, v, 1, 1, 3, 3, 5, 5, 7, 7, 9, 9, 11, 11, 13, 13, 15, 15);
+    }
+};
+
+// The helpers below are shared with the baseline ISA, so 16-bit lane
+// vectors (256 bits under AVX2) only cross them by reference: passing
+// them by value would change the ABI.
+template <typename V>
+SIMD_INLINE void loadVec(V& v, const void* p) {
+    std::memcpy(&v, p, sizeof(V));
+}
+
+// Loads bytes and widens them to the lane type of v.
+template <typename U8, typename V>
+SIMD_INLINE void loadWiden(V& v, const uint8_t* p) {
+    U8 bytes;
+    loadVec(bytes, p);
+    v = __builtin_convertvector(bytes, V);
+}
+
+template <typename V>
+SIMD_INLINE void storeVec(void* p, const V& v) {
+    std::memcpy(p, &v, sizeof(V));
+}
+
+// Signed lanes -> [0, 255] -> narrowed to bytes.
+template <typename U8, typename V>
+SIMD_INLINE U8 saturateToU8(const V& in) {
+    V v = in & (V)(in > 0);
+    V over = (V)(v > 255);
+    v = (v & ~over) | (over & 255);
+    return __builtin_convertvector(v, U8);
+}
+
+// Lanes >> 8, narrowed to bytes (values already fit).
+template <typename U8, typename V>
+SIMD_INLINE U8 narrowHigh(const V& v) {
+    return __builtin_convertvector((V)(v >> 8), U8);
+}
+
+template <class S>
+SIMD_INLINE void yuvToRgbRowSimd(const uint8_t* yRow, const uint8_t* vuRow, uint8_t* r, uint8_t* g, uint8_t* b, int w) {
+    typedef typename S::u8 u8;
+    typedef typename S::i16 i16;
+    int x = 0;
+    for (; x + S::N <= w; x += S::N) {
+        // 298 = 256 + 42, 409 = 256 + 153, -208 = -256 + 48, 516 = 512 + 4.
+        // The multiples of 256 pass through the shift exactly, so the
+        // remainders stay within +-30000 and match the reference bit for bit.
+        u8 vu;
+        loadVec(vu, vuRow + x);
+        i16 y;
+        loadWiden<u8>(y, yRow + x);
+        y -= 16;
+        i16 v = __builtin_convertvector(S::dupEven(vu), i16) - 128;
+        i16 u = __builtin_convertvector(S::dupOdd(vu), i16) - 128;
+        i16 t = y * 42 + 128;
+        storeVec(r + x, saturateToU8<u8>((i16)(y + v + ((t + v * 153) >> 8))));
+        storeVec(g + x, saturateToU8<u8>((i16)(y - v + ((t - u * 100 + v * 48) >> 8))));
+        storeVec(b + x, saturateToU8<u8>((i16)(y + (u << 1) + ((t + (u << 2)) >> 8))));
+    }
+    for (; x < w; ++x) yuvToRgbPixel(yRow[x], vuRow[x | 1], vuRow[x & ~1], r + x, g + x, b + x);
+}
+
+template <class S>
+SIMD_INLINE void hblurRowSimd(const uint8_t* src, uint16_t* dst, int w) {
+    typedef typename S::u8 u8;
+    typedef typename S::u16 u16;
+    int x = 0;
+    for (; x < 2 && x < w; ++x) dst[x] = hblurPixel(src, x, w);
+    for (; x + S::N + 2 <= w; x += S::N) {
+        u16 a, b, c, d, e;
+        loadWiden<u8>(a, src + x - 2);
+        loadWiden<u8>(b, src + x - 1);
+        loadWiden<u8>(c, src + x);
+        loadWiden<u8>(d, src + x + 1);
+        loadWiden<u8>(e, src + x + 2);
+        storeVec(dst + x, (u16)(a + e + ((b + d) << 2) + c * 6));
+    }
+    for (; x < w; ++x) dst[x] = hblurPixel(src, x, w);
+}
+
+template <class S>
+SIMD_INLINE void vblurRowSimd(const uint16_t* const* rows, uint8_t* dst, int w) {
+    typedef typename S::u8 u8;
+    typedef typename S::u16 u16;
+    int x = 0;
+    for (; x + S::N <= w; x += S::N) {
+        u16 r0, r1, r2, r3, r4;
+        loadVec(r0, rows[0] + x);
+        loadVec(r1, rows[1] + x);
+        loadVec(r2, rows[2] + x);
+        loadVec(r3, rows[3] + x);
+        loadVec(r4, rows[4] + x);
+        // Max 16 * 4080 + 128 = 65408, still fits 16 bits.
+        storeVec(dst + x, narrowHigh<u8>((u16)(r0 + r4 + ((r1 + r3) << 2) + r2 * 6 + 128)));
+    }
+    for (; x < w; ++x) dst[x] = vblurPixel(rows, x);
+}
+
+template <class S>
+SIMD_INLINE void grayRowSimd(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* dst, int w) {
+    typedef typename S::u8 u8;
+    typedef typename S::u16 u16;
+    int x = 0;
+    for (; x + S::N <= w; x += S::N) {
+        u16 rv, gv, bv;
+        loadWiden<u8>(rv, r + x);
+        loadWiden<u8>(gv, g + x);
+        loadWiden<u8>(bv, b + x);
+        storeVec(dst + x, narrowHigh<u8>((u16)(rv * 77 + gv * 150 + bv * 29 + 128)));
+    }
+    for (; x < w; ++x) dst[x] = grayPixel(r[x], g[x], b[x]);
+}
+
+template <class S>
+SIMD_INLINE void sobelRowSimd(const uint8_t* a, const uint8_t* c, const uint8_t* b, uint8_t* dst, int w) {
+    typedef typename S::u8 u8;
+    typedef typename S::i16 i16;
+    int x = 0;
+    for (; x < 1 && x < w; ++x) dst[x] = sobelPixel(a, c, b, x, w);
+    for (; x + S::N + 1 <= w; x += S::N) {
+        i16 al, ac, ar, cl, cr, bl, bc, br;
+        loadWiden<u8>(al, a + x - 1);
+        loadWiden<u8>(ac, a + x);
+        loadWiden<u8>(ar, a + x + 1);
+        loadWiden<u8>(cl, c + x - 1);
+        loadWiden<u8>(cr, c + x + 1);
+        loadWiden<u8>(bl, b + x - 1);
+        loadWiden<u8>(bc, b + x);
+        loadWiden<u8>(br, b + x + 1);
+        i16 gx = (ar + (cr << 1) + br) - (al + (cl << 1) + bl);
+        i16 gy = (bl + (bc << 1) + br) - (al + (ac << 1) + ar);
+        i16 sx = gx >> 15;
+        i16 sy = gy >> 15;
+        storeVec(dst + x, saturateToU8<u8>((i16)(((gx ^ sx) - sx) + ((gy ^ sy) - sy))));
+    }
+    for (; x < w; ++x) dst[x] = sobelPixel(a, c, b, x, w);
+}
+
+template <class S>
+SIMD_INLINE void vresizeRowSimd(const uint16_t* h0, const uint16_t* h1, int fy, uint8_t* dst, int w) {
+    typedef typename S::u8 u8;
+    typedef typename S::u16 u16;
+    u16 w0 = u16{} + (uint16_t)(256 - fy);
+    u16 w1 = u16{} + (uint16_t)fy;
+    int x = 0;
+    for (; x + S::N <= w; x += S::N) {
+        // The 8.8 rows are weighted as integer and fraction bytes separately,
+        // each sum <= 255 * 256. hi + lo / 256 is the full sum / 256 <= 65280,
+        // so adding the rounding term cannot overflow either.
+        u16 a, b;
+        loadVec(a, h0 + x);
+        loadVec(b, h1 + x);
+        u16 hi = (a >> 8) * w0 + (b >> 8) * w1;
+        u16 lo = (a & 255) * w0 + (b & 255) * w1;
+        storeVec(dst + x, narrowHigh<u8>((u16)(hi + (lo >> 8) + 128)));
+    }
+    for (; x < w; ++x) dst[x] = vresizePixel(h0[x], h1[x], fy);
+}
+
+// Stamps out one non-template entry point per row kernel, compiled with
+// TARGET, so a wider ISA can be selected at runtime from the same source.
+#define DEFINE_SIMD_ROW_KERNELS(PREFIX, TARGET, TRAITS)                                                        \
+    TARGET static void PREFIX##YuvToRgb(const uint8_t* y, const uint8_t* vu, uint8_t* r, uint8_t* g,          \
+                                        uint8_t* b, int w) { yuvToRgbRowSimd<TRAITS>(y, vu, r, g, b, w); }    \
+    TARGET static void PREFIX##Hblur(const uint8_t* s, uint16_t* d, int w) { hblurRowSimd<TRAITS>(s, d, w); } \
+    TARGET static void PREFIX##Vblur(const uint16_t* const* rows, uint8_t* d, int w) {                        \
+        vblurRowSimd<TRAITS>(rows, d, w);                                                                     \
+    }                                                                                                         \
+    TARGET static void PREFIX##Gray(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* d, int w) { \
+        grayRowSimd<TRAITS>(r, g, b, d, w);                                                                   \
+    }                                                                                                         \
+    TARGET static void PREFIX##Sobel(const uint8_t* a, const uint8_t* c, const uint8_t* b, uint8_t* d, int w) {\
+        sobelRowSimd<TRAITS>(a, c, b, d, w);                                                                  \
+    }                                                                                                         \
+    TARGET static void PREFIX##Vresize(const uint16_t* h0, const uint16_t* h1, int fy, uint8_t* d, int w) {   \
+        vresizeRowSimd<TRAITS>(h0, h1, fy, d, w);                                                             \
+    }                                                                                                         \
+    static const RowKernels PREFIX##Kernels = {                                                               \
+        PREFIX##YuvToRgb, PREFIX##Hblur, PREFIX##Vblur, PREFIX##Gray, PREFIX##Sobel, PREFIX##Vresize          \
+    };
+
+DEFINE_SIMD_ROW_KERNELS(simd128, , Simd128)
+
+#if defined(__x86_64__) || defined(__i386__)
+DEFINE_SIMD_ROW_KERNELS(avx2, __attribute__((target("avx2"))), Simd256)
+#endif
+
+static const RowKernels& selectSimdKernels(std::string& path) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (CpuInfo::features().avx2) {
+        path = "avx2";
+        return avx2Kernels;
+    }
+    path = "sse2";
+#elif defined(__aarch64__) || defined(__arm__)
+    path = "neon";
+#else
+    path = "generic128";
+#endif
+    return simd128Kernels;
+}
+
+// =========================================================
+// PIPELINE
+// =========================================================
+
+struct Frame {
+    int w, h, ow, oh;
+    std::vector<uint8_t> yuv;      // NV21: w*h luma, then w*h/2 interleaved VU
+    std::vector<uint8_t> rgb;      // 3 planes
+    std::vector<uint8_t> blurred;  // 3 planes
+    std::vector<uint8_t> edges;
+    std::vector<uint8_t> output;   // ow x oh
+    std::vector<int> xIndex, xFrac, yIndex, yFrac;
+
+    size_t plane() const { return (size_t)w * h; }
+};
+
+// Small ring of rows keyed by row index. get(y) returns the cached row or
+// computes it with fill(y, row). Rows are requested in increasing order,
+// so RING_SLOTS only has to cover the widest vertical window.
+template <typename T>
+class RowRing {
+public:
+    RowRing(int rowWidth, int rowPlanes)
+        : width(rowWidth), planes(rowPlanes),
+          data((size_t)RING_SLOTS * rowPlanes * rowWidth), tags(RING_SLOTS, -1) {}
+
+    template <typename Fill>
+    T* get(int y, Fill fill) {
+        int s = y % RING_SLOTS;
+        T* row = data.data() + (size_t)s * planes * width;
+        if (tags[s] != y) {
+            fill(y, row);
+            tags[s] = y;
+        }
+        return row;
+    }
+
+private:
+    int width;
+    int planes;
+    std::vector<T> data;
+    std::vector<int> tags;
+};
+
+// Hands out [r0, r1) tiles from a shared counter, so faster cores
+// (big.LITTLE) simply take more tiles. fn(thread, r0, r1).
+template <typename Fn>
+static void forEachTile(int rows, int tileRows, unsigned int numThreads, Fn fn) {
+    std::atomic<int> next(0);
+    parallelFor(numThreads, [&](unsigned int t) {
+        while (true) {
+            int r0 = next.fetch_add(tileRows);
+            if (r0 >= rows) break;
+            fn(t, r0, std::min(rows, r0 + tileRows));
+        }
+    });
+}
+
+// Half-pixel-centre bilinear mapping, 8-bit fraction.
+static void buildResizeTables(int src, int dst, std::vector<int>& index, std::vector<int>& frac) {
+    index.resize(dst);
+    frac.resize(dst);
+    double scale = (double)src / dst;
+    for (int i = 0; i < dst; ++i) {
+        double s = std::max(0.0, (i + 0.5) * scale - 0.5);
+        int i0 = std::min((int)s, src - 1);
+        index[i] = i0;
+        frac[i] = (int)((s - i0) * 256.0 + 0.5);
+    }
+}
+
+// Horizontal bilinear taps are a gather, kept scalar for every path.
+static void hresizeRow(const Frame& f, const uint8_t* src, uint16_t* dst) {
+    for (int ox = 0; ox < f.ow; ++ox) {
+        int x0 = f.xIndex[ox];
+        int x1 = std::min(x0 + 1, f.w - 1);
+        int fx = f.xFrac[ox];
+        dst[ox] = (uint16_t)(src[x0] * (256 - fx) + src[x1] * fx);
+    }
+}
+
+static void makeSyntheticFrame(Frame& f) {
+    size_t plane = f.plane();
+    f.yuv.resize(plane + plane / 2);
+    uint32_t state = 2463534242u;
+    for (int y = 0; y < f.h; ++y) {
+        for (int x = 0; x < f.w; ++x) {
+            state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+            int base = ((x >> 3) * 7 + (y >> 3) * 5 + ((x * y) >> 10)) & 255;
+            f.yuv[(size_t)y * f.w + x] = (uint8_t)std::min(235, std::max(16, base + (int)(state & 15) - 8));
+        }
+    }
+    for (int y = 0; y < f.h / 2; ++y) {
+        for (int x = 0; x < f.w; x += 2) {
+            f.yuv[plane + (size_t)y * f.w + x] = (uint8_t)(128 + ((x * 3 + y) & 63) - 32);     // V
+            f.yuv[plane + (size_t)y * f.w + x + 1] = (uint8_t)(128 + ((x + y * 2) & 63) - 32); // U
+        }
+    }
+    f.rgb.resize(plane * 3);
+    f.blurred.resize(plane * 3);
+    f.edges.resize(plane);
+    f.output.resize((size_t)f.ow * f.oh);
+    buildResizeTables(f.w, f.ow, f.xIndex, f.xFrac);
+    buildResizeTables(f.h, f.oh, f.yIndex, f.yFrac);
+}
+
+// Vertical 5-tap blur of row y from a ring of horizontally blurred rows.
+template <typename HFill>
+static void blurRow(const Frame& f, const RowKernels& k, RowRing<uint16_t>& hring, HFill hfill,
+                    int y, uint8_t* const dst[3]) {
+    const uint16_t* taps[5];
+    for (int i = 0; i < 5; ++i) taps[i] = hring.get(clampIndex(y + i - 2, f.h), hfill);
+    for (int p = 0; p < 3; ++p) {
+        const uint16_t* rows[5];
+        for (int i = 0; i < 5; ++i) rows[i] = taps[i] + (size_t)p * f.w;
+        k.vblur(rows, dst[p], f.w);
+    }
+}
+
+// ---- Stage by stage: every stage streams the whole frame through memory ----
+
+static double stageYuvToRgb(Frame& f, const RowKernels& k, unsigned int numThreads) {
+    const size_t plane = f.plane();
+    return timeSeconds([&]() {
+        forEachTile(f.h, TILE_ROWS, numThreads, [&](unsigned int, int r0, int r1) {
+            for (int y = r0; y < r1; ++y) {
+                size_t row = (size_t)y * f.w;
+                k.yuvToRgb(f.yuv.data() + row, f.yuv.data() + plane + (size_t)(y / 2) * f.w,
+                           f.rgb.data() + row, f.rgb.data() + plane + row, f.rgb.data() + 2 * plane + row, f.w);
+            }
+        });
+    });
+}
+
+static double stageBlur(Frame& f, const RowKernels& k, unsigned int numThreads) {
+    const size_t plane = f.plane();
+    std::vector<RowRing<uint16_t>> rings(numThreads, RowRing<uint16_t>(f.w, 3));
+    auto hfill = [&](int y, uint16_t* out) {
+        for (int p = 0; p < 3; ++p) k.hblur(f.rgb.data() + p * plane + (size_t)y * f.w, out + (size_t)p * f.w, f.w);
+    };
+    return timeSeconds([&]() {
+        forEachTile(f.h, TILE_ROWS, numThreads, [&](unsigned int t, int r0, int r1) {
+            for (int y = r0; y < r1; ++y) {
+                size_t row = (size_t)y * f.w;
+                uint8_t* dst[3] = { f.blurred.data() + row, f.blurred.data() + plane + row,
+                                    f.blurred.data() + 2 * plane + row };
+                blurRow(f, k, rings[t], hfill, y, dst);
+            }
+        });
+    });
+}
+
+static double stageSobel(Frame& f, const RowKernels& k, unsigned int numThreads) {
+    const size_t plane = f.plane();
+    std::vector<RowRing<uint8_t>> rings(numThreads, RowRing<uint8_t>(f.w, 1));
+    auto gfill = [&](int y, uint8_t* out) {
+        size_t row = (size_t)y * f.w;
+        k.gray(f.blurred.data() + row, f.blurred.data() + plane + row, f.blurred.data() + 2 * plane + row, out, f.w);
+    };
+    return timeSeconds([&]() {
+        forEachTile(f.h, TILE_ROWS, numThreads, [&](unsigned int t, int r0, int r1) {
+            for (int y = r0; y < r1; ++y) {
+                const uint8_t* above = rings[t].get(clampIndex(y - 1, f.h), gfill);
+                const uint8_t* row = rings[t].get(y, gfill);
+                const uint8_t* below = rings[t].get(clampIndex(y + 1, f.h), gfill);
+                k.sobel(above, row, below, f.edges.data() + (size_t)y * f.w, f.w);
+            }
+        });
+    });
+}
+
+static double stageResize(Frame& f, const RowKernels& k, unsigned int numThreads) {
+    std::vector<RowRing<uint16_t>> rings(numThreads, RowRing<uint16_t>(f.ow, 1));
+    auto hfill = [&](int y, uint16_t* out) { hresizeRow(f, f.edges.data() + (size_t)y * f.w, out); };
+    return timeSeconds([&]() {
+        forEachTile(f.oh, TILE_ROWS, numThreads, [&](unsigned int t, int r0, int r1) {
+            for (int oy = r0; oy < r1; ++oy) {
+                int y0 = f.yIndex[oy];
+                const uint16_t* h0 = rings[t].get(y0, hfill);
+                const uint16_t* h1 = rings[t].get(std::min(y0 + 1, f.h - 1), hfill);
+                k.vresize(h0, h1, f.yFrac[oy], f.output.data() + (size_t)oy * f.ow, f.ow);
+            }
+        });
+    });
+}
+
+// ---- Fused: each tile of output rows pulls its source rows through line buffers ----
+
+struct FusedState {
+    RowRing<uint8_t> rgb;
+    RowRing<uint16_t> hblur;
+    RowRing<uint8_t> gray;
+    RowRing<uint8_t> edges;
+    RowRing<uint16_t> hresize;
+    std::vector<uint8_t> blurred;  // one 3-plane row
+
+    FusedState(int w, int ow)
+        : rgb(w, 3), hblur(w, 3), gray(w, 1), edges(w, 1), hresize(ow, 1), blurred((size_t)3 * w) {}
+};
+
+static void runFused(Frame& f, const RowKernels& k, unsigned int numThreads) {
+    const size_t plane = f.plane();
+    const int w = f.w;
+    std::vector<FusedState> states(numThreads, FusedState(f.w, f.ow));
+
+    forEachTile(f.oh, FUSED_TILE_ROWS, numThreads, [&](unsigned int t, int r0, int r1) {
+        FusedState& s = states[t];
+
+        auto rgbFill = [&](int y, uint8_t* out) {
+            k.yuvToRgb(f.yuv.data() + (size_t)y * w, f.yuv.data() + plane + (size_t)(y / 2) * w,
+                       out, out + w, out + 2 * w, w);
+        };
+        auto hblurFill = [&](int y, uint16_t* out) {
+            const uint8_t* rgb = s.rgb.get(y, rgbFill);
+            for (int p = 0; p < 3; ++p) k.hblur(rgb + (size_t)p * w, out + (size_t)p * w, w);
+        };
+        auto grayFill = [&](int y, uint8_t* out) {
+            uint8_t* dst[3] = { s.blurred.data(), s.blurred.data() + w, s.blurred.data() + 2 * w };
+            blurRow(f, k, s.hblur, hblurFill, y, dst);
+            k.gray(dst[0], dst[1], dst[2], out, w);
+        };
+        auto edgeFill = [&](int y, uint8_t* out) {
+            const uint8_t* above = s.gray.get(clampIndex(y - 1, f.h), grayFill);
+            const uint8_t* row = s.gray.get(y, grayFill);
+            const uint8_t* below = s.gray.get(clampIndex(y + 1, f.h), grayFill);
+            k.sobel(above, row, below, out, w);
+        };
+        auto hresizeFill = [&](int y, uint16_t* out) { hresizeRow(f, s.edges.get(y, edgeFill), out); };
+
+        for (int oy = r0; oy < r1; ++oy) {
+            int y0 = f.yIndex[oy];
+            const uint16_t* h0 = s.hresize.get(y0, hresizeFill);
+            const uint16_t* h1 = s.hresize.get(std::min(y0 + 1, f.h - 1), hresizeFill);
+            k.vresize(h0, h1, f.yFrac[oy], f.output.data() + (size_t)oy * f.ow, f.ow);
+        }
+    });
+}
+
+// =========================================================
+// SUITE
+// =========================================================
+
+static const char* const STAGE_NAMES[4] = { "yuv_to_rgb", "gaussian_blur", "sobel", "bilinear_resize" };
+
+// Best per-stage wall time over `repeats` stage-by-stage runs.
+static void runUnfused(Frame& f, const RowKernels& k, unsigned int numThreads, int repeats, double best[4]) {
+    for (int rep = 0; rep < repeats; ++rep) {
+        double sec[4] = {
+            stageYuvToRgb(f, k, numThreads),
+            stageBlur(f, k, numThreads),
+            stageSobel(f, k, numThreads),
+            stageResize(f, k, numThreads),
+        };
+        for (int s = 0; s < 4; ++s) {
+            if (rep == 0 || sec[s] < best[s]) best[s] = sec[s];
+        }
+    }
+}
+
+ImagePipelineBenchmark::ImagePipelineBenchmark(const BenchmarkSizes& sizes)
+        : imageRepeats(sizes.imageRepeats) {}
+
+ImagePipelineBenchmark::ImageScores ImagePipelineBenchmark::runImageSuite() {
+    LOGD("--- STARTING IMAGE PIPELINE BENCHMARK ---");
+
+    ImageScores scores;
+    scores.verified = true;
+    const RowKernels& simd = selectSimdKernels(scores.simdPath);
+    unsigned int numCores = CpuInfo::coreCount();
+
+    Frame f;
+    f.w = FRAME_WIDTH;
+    f.h = FRAME_HEIGHT;
+    f.ow = OUTPUT_WIDTH;
+    f.oh = OUTPUT_HEIGHT;
+    makeSyntheticFrame(f);
+
+    const double framePixels = (double)f.w * f.h;
+    const double stagePixels[4] = { framePixels, framePixels, framePixels, (double)f.ow * f.oh };
+
+    // 1. Scalar reference (also the verification baseline)
+    double scalarSec[4];
+    runUnfused(f, scalarKernels, numCores, 1, scalarSec);
+    std::vector<uint8_t> refBlurred = f.blurred;
+    std::vector<uint8_t> refEdges = f.edges;
+    std::vector<uint8_t> refOutput = f.output;
+
+    // 2. SIMD, stage by stage
+    double simdSec[4];
+    runUnfused(f, simd, numCores, imageRepeats, simdSec);
+    if (f.blurred != refBlurred || f.edges != refEdges || f.output != refOutput) scores.verified = false;
+
+    double unfusedSec = 0.0;
+    for (int s = 0; s < 4; ++s) {
+        unfusedSec += simdSec[s];
+        scores.stages.push_back({ STAGE_NAMES[s],
+                                  stagePixels[s] / 1e6 / std::max(simdSec[s], 1e-9),
+                                  stagePixels[s] / 1e6 / std::max(scalarSec[s], 1e-9) });
+        LOGD("%s: %.1f Mpix/s (scalar %.1f)", STAGE_NAMES[s], scores.stages[s].simdMpixPerSec,
+             scores.stages[s].scalarMpixPerSec);
+    }
+    scores.unfusedMpixPerSec = framePixels / 1e6 / std::max(unfusedSec, 1e-9);
+
+    // 3. SIMD, fused tiles
+    double fusedSec = 0.0, fusedSingleSec = 0.0;
+    for (int rep = 0; rep < imageRepeats; ++rep) {
+        std::fill(f.output.begin(), f.output.end(), 0);
+        double sec = timeSeconds([&]() { runFused(f, simd, numCores); });
+        if (rep == 0 || sec < fusedSec) fusedSec = sec;
+        if (f.output != refOutput) scores.verified = false;
+    }
+    fusedSingleSec = timeSeconds([&]() { runFused(f, simd, 1); });
+    if (f.output != refOutput) scores.verified = false;
+
+    scores.fusedMpixPerSec = framePixels / 1e6 / std::max(fusedSec, 1e-9);
+    scores.fusedSingleCoreMpixPerSec = framePixels / 1e6 / std::max(fusedSingleSec, 1e-9);
+    LOGD("End-to-end (%s): unfused %.1f, fused %.1f, fused 1-core %.1f Mpix/s", scores.simdPath.c_str(),
+         scores.unfusedMpixPerSec, scores.fusedMpixPerSec, scores.fusedSingleCoreMpixPerSec);
+
+    if (!scores.verified) LOGE("Image pipeline verification FAILED (%s)", scores.simdPath.c_str());
+    return scores;
+}
+
+size_t ImagePipelineBenchmark::workingSetBytes() const {
+    // NV21 (1.5) + RGB (3) + blurred RGB (3) + edges (1) per frame pixel.
+    return (size_t)FRAME_WIDTH * FRAME_HEIGHT * 17 / 2 + (size_t)OUTPUT_WIDTH * OUTPUT_HEIGHT;
+}
+
+// =========================================================
+// REGISTRATION
+// =========================================================
+
+// SIMD vs scalar throughput of one pipeline stage.
+static std::string stageResultToJson(const ImagePipelineBenchmark::StageResult& s) {
+    std::stringstream ss;
+    ss << "{";
+    ss << "\"name\":\"" << s.name << "\", ";
+    ss << "\"simdMpixPerSec\":" << s.simdMpixPerSec << ", ";
+    ss << "\"scalarMpixPerSec\":" << s.scalarMpixPerSec;
+    ss << "}";
+    return ss.str();
+}
+
+class ImagePipelineKernel : public BenchmarkKernel {
+public:
+    void setup(const BenchmarkSizes& sizes) override {
+        img.reset(new ImagePipelineBenchmark(sizes));
+        workingSet = img->workingSetBytes();
+    }
+    void run() override { scores = img->runImageSuite(); }
+    bool verify() override { return scores.verified; }
+    void teardown() override { img.reset(); }
+    double score() const override { return scores.fusedMpixPerSec; }
+    size_t workingSetBytes() const override { return workingSet; }
+    static size_t workingSetHint(const BenchmarkSizes& sizes) { return ImagePipelineBenchmark(sizes).workingSetBytes(); }
+    void writeJson(std::ostream& out) const override {
+        out << "\"imagePipeline\":{";
+        out << "\"simdPath\":\"" << scores.simdPath << "\", ";
+        out << "\"verified\":" << (scores.verified ? "true" : "false") << ", ";
+        out << "\"unfusedMpixPerSec\":" << scores.unfusedMpixPerSec << ", ";
+        out << "\"fusedMpixPerSec\":" << scores.fusedMpixPerSec << ", ";
+        out << "\"fusedSingleCoreMpixPerSec\":" << scores.fusedSingleCoreMpixPerSec << ", ";
+        out << "\"stages\":" << jsonArray(scores.stages, stageResultToJson);
+        out << "}";
+    }
+
+private:
+    std::unique_ptr<ImagePipelineBenchmark> img;
+    ImagePipelineBenchmark::ImageScores scores = {};
+    size_t workingSet = 0;
+};
+
+static KernelRegistration<ImagePipelineKernel> registration(
+        "image_pipeline", "image", {"single_core", "multi_core", "simd", "memory_bound"}, 0, 0.0, 70);
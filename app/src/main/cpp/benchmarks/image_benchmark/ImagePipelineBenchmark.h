@@ -0,0 +1,49 @@
+//
+// Created by Marius on 18/10/2026.
+//
+
+#ifndef PERFORMIC_IMAGEPIPELINEBENCHMARK_H
+#define PERFORMIC_IMAGEPIPELINEBENCHMARK_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "BenchmarkSizes.h"
+
+// Camera-style streaming pipeline on a synthetic 12 MP NV21 frame:
+// YUV -> RGB, 5x5 Gaussian blur, Sobel edges, bilinear downscale.
+// Row tiles are scheduled dynamically over all cores. Every stage has a
+// scalar reference and a SIMD version that must match it bit for bit.
+class ImagePipelineBenchmark {
+public:
+    struct StageResult {
+        std::string name;
+        double simdMpixPerSec;    // all cores, stage output pixels
+        double scalarMpixPerSec;  // all cores, scalar reference
+    };
+
+    struct ImageScores {
+        std::string simdPath;            // "neon", "sse2" or "avx2"
+        std::vector<StageResult> stages;
+        double unfusedMpixPerSec;        // end-to-end, frame pixels, stage by stage
+        double fusedMpixPerSec;          // end-to-end, all stages per tile (line buffers)
+        double fusedSingleCoreMpixPerSec;
+        bool verified;
+    };
+
+    explicit ImagePipelineBenchmark(const BenchmarkSizes& sizes);
+
+    ImageScores runImageSuite();
+
+    size_t workingSetBytes() const;
+
+private:
+    static constexpr int FRAME_WIDTH = 4000;
+    static constexpr int FRAME_HEIGHT = 3000;
+    static constexpr int OUTPUT_WIDTH = 1920;
+    static constexpr int OUTPUT_HEIGHT = 1440;
+
+    int imageRepeats;
+};
+
+#endif //PERFORMIC_IMAGEPIPELINEBENCHMARK_H
@@ -1,5 +1,6 @@
 #include "MemoryBenchmark.h"
 #include "utils.h" // For ClobberMemory
+#include "BenchmarkRegistry.h"
 #include <vector>
 #include <chrono>
 #include <cstring> // For memcpy
@@ -10,27 +11,31 @@
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
 
 // --- CONFIGURATION ---
-constexpr int SIZE_L1  = 32 * 1024;        // 32 KB (Fits in L1)
-constexpr int SIZE_L2  = 512 * 1024;       // 512 KB (Fits in L2/L3)
-constexpr int SIZE_RAM = 64 * 1024 * 1024; // 64 MB (Forces RAM access)
+// Buffer sizes come from BenchmarkSizes: half of L1, half of L2, and a RAM
+// buffer several times the last-level cache. Each level copies a fixed
+// number of bytes, so small buffers simply run more iterations.
 
-constexpr int ITERATIONS_CACHE = 50000; // Run many times because cache is fast
-constexpr int ITERATIONS_RAM   = 500;   // Run fewer times because RAM is slow
+MemoryBenchmark::MemoryBenchmark(const BenchmarkSizes& sizes)
+        : l1Bytes(sizes.memL1Bytes),
+          l2Bytes(sizes.memL2Bytes),
+          ramBytes(sizes.memRamBytes),
+          cacheBytesMoved(sizes.cacheBytesMoved),
+          ramBytesMoved(sizes.ramBytesMoved) {}
 
 MemoryBenchmark::MemoryScores MemoryBenchmark::runMemorySuite() {
     LOGD("--- STARTING MEMORY BENCHMARK ---");
 
     // 1. Measure L1 Cache
-    double l1GBs = measureBandwidth(SIZE_L1);
-    LOGD("L1 Cache Speed: %.2f GB/s", l1GBs);
+    double l1GBs = measureBandwidth(l1Bytes, cacheBytesMoved);
+    LOGD("L1 Cache Speed: %.2f GB/s (%zu KB)", l1GBs, l1Bytes / 1024);
 
     // 2. Measure L2 Cache
-    double l2GBs = measureBandwidth(SIZE_L2);
-    LOGD("L2 Cache Speed: %.2f GB/s", l2GBs);
+    double l2GBs = measureBandwidth(l2Bytes, cacheBytesMoved);
+    LOGD("L2 Cache Speed: %.2f GB/s (%zu KB)", l2GBs, l2Bytes / 1024);
 
     // 3. Measure RAM (DRAM)
-    double ramGBs = measureBandwidth(SIZE_RAM);
-    LOGD("RAM Speed: %.2f GB/s", ramGBs);
+    double ramGBs = measureBandwidth(ramBytes, ramBytesMoved);
+    LOGD("RAM Speed: %.2f GB/s (%zu MB)", ramGBs, ramBytes / (1024 * 1024));
 
     // --- SCORING ---
     // Baseline: P30 Lite (LPDDR4X)
@@ -46,18 +51,18 @@ MemoryBenchmark::MemoryScores MemoryBenchmark::runMemorySuite() {
     return { l1GBs, l2GBs, ramGBs, ramScore + cacheBonus };
 }
 
-double MemoryBenchmark::measureBandwidth(int bufferSize) {
+double MemoryBenchmark::measureBandwidth(size_t bufferSize, double bytesMoved) {
     // 1. Allocate Source and Dest buffers
     std::vector<uint8_t> src(bufferSize, 1);
     std::vector<uint8_t> dest(bufferSize, 0);
 
     // Determine iterations based on size
     // (Run more iterations for small buffers to get accurate time)
-    int iterations = (bufferSize < 1024*1024) ? ITERATIONS_CACHE : ITERATIONS_RAM;
+    long long iterations = std::max(1LL, (long long)(bytesMoved / (double)bufferSize));
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    for (int i = 0; i < iterations; ++i) {
+    for (long long i = 0; i < iterations; ++i) {
         // The Core Operation: Memory Copy
         std::memcpy(dest.data(), src.data(), bufferSize);
 
@@ -76,4 +81,43 @@ double MemoryBenchmark::measureBandwidth(int bufferSize) {
     double throughputGBs = (double)totalBytes / 1e9 / durationSec;
 
     return throughputGBs;
-}
\ No newline at end of file
+}
+
+size_t MemoryBenchmark::workingSetBytes() const {
+    return 2 * ramBytes; // source + destination
+}
+
+// =========================================================
+// REGISTRATION
+// =========================================================
+
+class MemoryKernel : public BenchmarkKernel {
+public:
+    void setup(const BenchmarkSizes& sizes) override {
+        mem.reset(new MemoryBenchmark(sizes));
+        workingSet = mem->workingSetBytes();
+    }
+    void run() override { scores = mem->runMemorySuite(); }
+    bool verify() override { return scores.l1Throughput > 0.0 && scores.ramThroughput > 0.0; }
+    void teardown() override { mem.reset(); }
+    double score() const override { return scores.memoryScore; }
+    // Three cache levels with different byte counts; there is no common unit.
+    int iterations() const override { return 0; }
+    size_t workingSetBytes() const override { return workingSet; }
+    static size_t workingSetHint(const BenchmarkSizes& sizes) { return MemoryBenchmark(sizes).workingSetBytes(); }
+    void writeJson(std::ostream& out) const override {
+        out << "\"ramScore\":" << scores.memoryScore << ", ";
+        out << "\"ramGBs\":" << scores.ramThroughput << ", ";
+        out << "\"l1GBs\":" << scores.l1Throughput << ", ";
+        out << "\"l2GBs\":" << scores.l2Throughput;
+    }
+
+private:
+    std::unique_ptr<MemoryBenchmark> mem;
+    MemoryBenchmark::MemoryScores scores = {};
+    size_t workingSet = 0;
+};
+
+// 1000 = P30 Lite RAM bandwidth (plus its small cache bonus).
+static KernelRegistration<MemoryKernel> registration(
+        "memory", "memory", {"single_core", "bandwidth"}, 1, 1000.0, 30);
@@ -1,8 +1,13 @@
 #ifndef PERFORMIC_MEMORYBENCHMARK_H
 #define PERFORMIC_MEMORYBENCHMARK_H
 
+#include <stddef.h>
+#include "BenchmarkSizes.h"
+
 class MemoryBenchmark {
 public:
+    explicit MemoryBenchmark(const BenchmarkSizes& sizes);
+
     struct MemoryScores {
         double l1Throughput;
         double l2Throughput;
@@ -12,8 +17,16 @@ public:
 
     MemoryScores runMemorySuite();
 
+    size_t workingSetBytes() const;
+
 private:
-    double measureBandwidth(int bufferSize);
+    size_t l1Bytes;
+    size_t l2Bytes;
+    size_t ramBytes;
+    double cacheBytesMoved;
+    double ramBytesMoved;
+
+    double measureBandwidth(size_t bufferSize, double bytesMoved);
 };
 
 #endif //PERFORMIC_MEMORYBENCHMARK_H
\ No newline at end of file
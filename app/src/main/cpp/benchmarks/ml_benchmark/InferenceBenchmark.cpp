@@ -0,0 +1,571 @@
+#include "InferenceBenchmark.h"
+#include "utils.h"
+#include "CpuInfo.h"
+#include "BenchmarkRegistry.h"
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <android/log.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#define LOG_TAG "PerformicML"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+// --- CONFIGURATION ---
+// Rows handed to one thread are a multiple of this, so every SIMD
+// micro-kernel (at most 8 rows tall) sees whole blocks.
+constexpr int ROW_ALIGN = 8;
+
+// =========================================================
+// INT8 GEMM
+// =========================================================
+// C[M x N] (int32) = A[M x K] (int8) * B[K x N] (int8).
+// B is stored transposed (N x K, "weights" layout) so both operands are
+// K-contiguous. K must be a multiple of 32 (the widest SIMD step).
+
+struct GemmArgs {
+    const int8_t* a;
+    const int8_t* bt;
+    const int32_t* bSums;   // per output column sum of B, for the u8 x s8 VNNI path
+    int32_t* c;
+    int n;
+    int k;
+};
+
+typedef void (*GemmRowsFn)(const GemmArgs& g, int rowBegin, int rowEnd);
+
+static void gemmScalarBlock(const GemmArgs& g, int r0, int r1, int c0, int c1) {
+    for (int i = r0; i < r1; ++i) {
+        const int8_t* a = g.a + (size_t)i * g.k;
+        for (int j = c0; j < c1; ++j) {
+            const int8_t* b = g.bt + (size_t)j * g.k;
+            int32_t acc = 0;
+            for (int kk = 0; kk < g.k; ++kk) {
+                acc += (int32_t)a[kk] * (int32_t)b[kk];
+            }
+            g.c[(size_t)i * g.n + j] = acc;
+        }
+    }
+}
+
+static void gemmScalar(const GemmArgs& g, int rowBegin, int rowEnd) {
+    gemmScalarBlock(g, rowBegin, rowEnd, 0, g.n);
+}
+
+#if defined(__aarch64__)
+typedef int8_t  i8x16 __attribute__((vector_size(16)));
+typedef int32_t i32x4 __attribute__((vector_size(16)));
+
+// SDOT (ARMv8.2 dotprod) and SMMLA (ARMv8.6 i8mm) as asm, since the
+// arm64-v8a baseline has neither; selectGemmKernel() picks them from the HWCAPs.
+#define SDOT(acc, a, b) \
+    asm(".arch_extension dotprod\n\tsdot %0.4s, %1.16b, %2.16b" : "+w"(acc) : "w"(a), "w"(b))
+#define SMMLA(acc, a, b) \
+    asm(".arch_extension i8mm\n\tsmmla %0.4s, %1.16b, %2.16b" : "+w"(acc) : "w"(a), "w"(b))
+
+static inline i8x16 load16(const int8_t* p) {
+    i8x16 v;
+    std::memcpy(&v, p, 16);
+    return v;
+}
+
+// 8 bytes of row `lo` in the low half, 8 bytes of row `hi` in the high half.
+static inline i8x16 loadRowPair(const int8_t* lo, const int8_t* hi) {
+    i8x16 v;
+    std::memcpy(&v, lo, 8);
+    std::memcpy((int8_t*)&v + 8, hi, 8);
+    return v;
+}
+
+static inline int32_t sumLanes(i32x4 v) {
+    return v[0] + v[1] + v[2] + v[3];
+}
+
+// 4x4 output block, 16 SDOT accumulators (one per C element, 4 partial sums each).
+static void gemmSdot(const GemmArgs& g, int rowBegin, int rowEnd) {
+    const int k = g.k;
+    const int n = g.n;
+    int rowEnd4 = rowBegin + (rowEnd - rowBegin) / 4 * 4;
+    int colEnd4 = n / 4 * 4;
+
+    for (int i = rowBegin; i < rowEnd4; i += 4) {
+        const int8_t* a = g.a + (size_t)i * k;
+        for (int j = 0; j < colEnd4; j += 4) {
+            const int8_t* b = g.bt + (size_t)j * k;
+            i32x4 acc[4][4] = {};
+            for (int kk = 0; kk < k; kk += 16) {
+                i8x16 av[4], bv[4];
+                for (int r = 0; r < 4; ++r) av[r] = load16(a + (size_t)r * k + kk);
+                for (int c = 0; c < 4; ++c) bv[c] = load16(b + (size_t)c * k + kk);
+                for (int r = 0; r < 4; ++r) {
+                    for (int c = 0; c < 4; ++c) SDOT(acc[r][c], av[r], bv[c]);
+                }
+            }
+            for (int r = 0; r < 4; ++r) {
+                for (int c = 0; c < 4; ++c) g.c[(size_t)(i + r) * n + j + c] = sumLanes(acc[r][c]);
+            }
+        }
+    }
+    gemmScalarBlock(g, rowBegin, rowEnd4, colEnd4, n);
+    gemmScalarBlock(g, rowEnd4, rowEnd, 0, n);
+}
+
+// 8x8 output block. Each SMMLA multiplies a 2x8 slice of A by an 8x2 slice
+// of B into a 2x2 tile: lanes = {C[r][c], C[r][c+1], C[r+1][c], C[r+1][c+1]}.
+static void gemmI8mm(const GemmArgs& g, int rowBegin, int rowEnd) {
+    const int k = g.k;
+    const int n = g.n;
+    int rowEnd8 = rowBegin + (rowEnd - rowBegin) / 8 * 8;
+    int colEnd8 = n / 8 * 8;
+
+    for (int i = rowBegin; i < rowEnd8; i += 8) {
+        const int8_t* a = g.a + (size_t)i * k;
+        for (int j = 0; j < colEnd8; j += 8) {
+            const int8_t* b = g.bt + (size_t)j * k;
+            i32x4 acc[4][4] = {};
+            for (int kk = 0; kk < k; kk += 8) {
+                i8x16 av[4], bv[4];
+                for (int p = 0; p < 4; ++p) {
+                    av[p] = loadRowPair(a + (size_t)(2 * p) * k + kk, a + (size_t)(2 * p + 1) * k + kk);
+                    bv[p] = loadRowPair(b + (size_t)(2 * p) * k + kk, b + (size_t)(2 * p + 1) * k + kk);
+                }
+                for (int p = 0; p < 4; ++p) {
+                    for (int q = 0; q < 4; ++q) SMMLA(acc[p][q], av[p], bv[q]);
+                }
+            }
+            for (int p = 0; p < 4; ++p) {
+                for (int q = 0; q < 4; ++q) {
+                    int32_t* c0 = g.c + (size_t)(i + 2 * p) * n + j + 2 * q;
+                    int32_t* c1 = c0 + n;
+                    c0[0] = acc[p][q][0];
+                    c0[1] = acc[p][q][1];
+                    c1[0] = acc[p][q][2];
+                    c1[1] = acc[p][q][3];
+                }
+            }
+        }
+    }
+    gemmScalarBlock(g, rowBegin, rowEnd8, colEnd8, n);
+    gemmScalarBlock(g, rowEnd8, rowEnd, 0, n);
+}
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VNNI_TARGET __attribute__((target("avx2,avxvnni")))
+
+VNNI_TARGET static inline int32_t hsum256(__m256i v) {
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+}
+
+// VPDPBUSD is u8 x s8: A is biased to unsigned with a ^ 0x80 (= a + 128)
+// and the extra 128 * sum(B column) is subtracted at the end.
+// 2x4 block keeps 8 accumulators + 6 operands inside the 16 YMM registers.
+VNNI_TARGET static void gemmAvxVnni(const GemmArgs& g, int rowBegin, int rowEnd) {
+    const int k = g.k;
+    const int n = g.n;
+    const __m256i bias = _mm256_set1_epi8((char)0x80);
+    int rowEnd2 = rowBegin + (rowEnd - rowBegin) / 2 * 2;
+    int colEnd4 = n / 4 * 4;
+
+    for (int i = rowBegin; i < rowEnd2; i += 2) {
+        const int8_t* a = g.a + (size_t)i * k;
+        for (int j = 0; j < colEnd4; j += 4) {
+            const int8_t* b = g.bt + (size_t)j * k;
+            __m256i acc[2][4];
+            for (int r = 0; r < 2; ++r) {
+                for (int c = 0; c < 4; ++c) acc[r][c] = _mm256_setzero_si256();
+            }
+            for (int kk = 0; kk < k; kk += 32) {
+                __m256i av[2], bv[4];
+                for (int r = 0; r < 2; ++r) {
+                    av[r] = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(a + (size_t)r * k + kk)), bias);
+                }
+                for (int c = 0; c < 4; ++c) {
+                    bv[c] = _mm256_loadu_si256((const __m256i*)(b + (size_t)c * k + kk));
+                }
+                for (int r = 0; r < 2; ++r) {
+                    for (int c = 0; c < 4; ++c) acc[r][c] = _mm256_dpbusd_avx_epi32(acc[r][c], av[r], bv[c]);
+                }
+            }
+            for (int r = 0; r < 2; ++r) {
+                for (int c = 0; c < 4; ++c) {
+                    g.c[(size_t)(i + r) * n + j + c] = hsum256(acc[r][c]) - 128 * g.bSums[j + c];
+                }
+            }
+        }
+    }
+    gemmScalarBlock(g, rowBegin, rowEnd2, colEnd4, n);
+    gemmScalarBlock(g, rowEnd2, rowEnd, 0, n);
+}
+#endif
+
+static GemmRowsFn selectGemmKernel(std::string& path) {
+    const CpuInfo::Features& isa = CpuInfo::features();
+#if defined(__aarch64__)
+    if (isa.i8mm) { path = "i8mm"; return gemmI8mm; }
+    if (isa.dotprod) { path = "sdot"; return gemmSdot; }
+#elif defined(__x86_64__) || defined(__i386__)
+    if (isa.avxvnni) { path = "avxvnni"; return gemmAvxVnni; }
+#endif
+    (void)isa;
+    path = "scalar";
+    return gemmScalar;
+}
+
+// Rows [r0, r1) of thread t when [0, m) is split into ROW_ALIGN-sized blocks.
+static void rowRange(int m, unsigned int t, unsigned int numThreads, int& r0, int& r1) {
+    int blocks = (m + ROW_ALIGN - 1) / ROW_ALIGN;
+    r0 = std::min((int)((long)blocks * t / numThreads) * ROW_ALIGN, m);
+    r1 = std::min((int)((long)blocks * (t + 1) / numThreads) * ROW_ALIGN, m);
+}
+
+template <typename Fn>
+static void forEachRowRange(int m, unsigned int numThreads, Fn fn) {
+    parallelFor(numThreads, [&](unsigned int t) {
+        int r0, r1;
+        rowRange(m, t, numThreads, r0, r1);
+        if (r0 < r1) fn(r0, r1);
+    });
+}
+
+// =========================================================
+// CONV STACK
+// =========================================================
+
+static inline int8_t randomInt8(uint32_t& state, int lo, int hi) {
+    state = state * 1664525u + 1013904223u;
+    return (int8_t)(lo + (int)((state >> 8) % (uint32_t)(hi - lo)));
+}
+
+static inline int8_t requantize(int32_t acc, int shift) {
+    int32_t v = (acc + (1 << (shift - 1))) >> shift;
+    return (int8_t)std::min(127, std::max(-128, v));
+}
+
+// Weights are drawn from [-16, 16) (sigma ~9.2) and activations stay around
+// sigma ~30, so a K-deep accumulator has sigma ~ 30 * 9.2 * sqrt(K).
+// Shifting by log2(9.2 * sqrt(K)) brings the output back to the same range.
+static int requantShift(int k) {
+    return std::max(1, (int)std::lround(std::log2(9.2 * std::sqrt((double)k))));
+}
+
+enum LayerType { CONV_3X3, DEPTHWISE_3X3, POINTWISE };
+
+struct ConvLayer {
+    const char* name;
+    LayerType type;
+    int inH, inW, inC, outC, stride;
+    int outH, outW, k, shift;
+    std::vector<int8_t> weights;    // outC x k (GEMM layers) or 9 x C (depthwise)
+    std::vector<int32_t> weightSums;
+    std::vector<int8_t> im2col;     // (outH * outW) x k, CONV_3X3 only
+    std::vector<int32_t> acc;       // (outH * outW) x outC, GEMM layers only
+    std::vector<int8_t> output;     // outH x outW x outC (NHWC)
+
+    double ops() const {
+        double macs = (type == DEPTHWISE_3X3) ? (double)outH * outW * outC * 9
+                                              : (double)outH * outW * outC * k;
+        return 2.0 * macs;
+    }
+};
+
+static ConvLayer makeLayer(const char* name, LayerType type, int inH, int inW, int inC, int outC,
+                           int stride, uint32_t seed) {
+    ConvLayer L;
+    L.name = name;
+    L.type = type;
+    L.inH = inH; L.inW = inW; L.inC = inC; L.outC = outC; L.stride = stride;
+    L.outH = (type == POINTWISE) ? inH : (inH + 2 - 3) / stride + 1;
+    L.outW = (type == POINTWISE) ? inW : (inW + 2 - 3) / stride + 1;
+    L.k = (type == CONV_3X3) ? 9 * inC : (type == POINTWISE ? inC : 9);
+    L.shift = requantShift(L.k);
+
+    size_t weightCount = (type == DEPTHWISE_3X3) ? (size_t)9 * outC : (size_t)outC * L.k;
+    L.weights.resize(weightCount);
+    for (auto& w : L.weights) w = randomInt8(seed, -16, 16);
+
+    if (type != DEPTHWISE_3X3) {
+        L.weightSums.assign(outC, 0);
+        for (int j = 0; j < outC; ++j) {
+            for (int kk = 0; kk < L.k; ++kk) L.weightSums[j] += L.weights[(size_t)j * L.k + kk];
+        }
+        L.acc.resize((size_t)L.outH * L.outW * outC);
+    }
+    if (type == CONV_3X3) {
+        L.im2col.resize((size_t)L.outH * L.outW * L.k);
+    }
+    L.output.resize((size_t)L.outH * L.outW * outC);
+    return L;
+}
+
+// Output rows [r0, r1) of the im2col matrix; one row per output pixel,
+// 3x3 taps x inC channels, zero padding of 1.
+static void im2colRows(ConvLayer& L, const int8_t* in, int r0, int r1) {
+    for (int r = r0; r < r1; ++r) {
+        int oy = r / L.outW;
+        int ox = r % L.outW;
+        int8_t* dst = L.im2col.data() + (size_t)r * L.k;
+        for (int ky = 0; ky < 3; ++ky) {
+            for (int kx = 0; kx < 3; ++kx) {
+                int iy = oy * L.stride + ky - 1;
+                int ix = ox * L.stride + kx - 1;
+                if (iy < 0 || iy >= L.inH || ix < 0 || ix >= L.inW) {
+                    std::memset(dst, 0, L.inC);
+                } else {
+                    std::memcpy(dst, in + ((size_t)iy * L.inW + ix) * L.inC, L.inC);
+                }
+                dst += L.inC;
+            }
+        }
+    }
+}
+
+// Intentionally plain C++: 9 MACs per output byte make depthwise layers
+// memory bound, and the channel loop is left to the compiler's
+// auto-vectorizer. The layer result reports its path as "scalar".
+static void depthwiseRows(ConvLayer& L, const int8_t* in, int oy0, int oy1) {
+    const int C = L.outC;
+    std::vector<int32_t> acc(C);
+    for (int oy = oy0; oy < oy1; ++oy) {
+        for (int ox = 0; ox < L.outW; ++ox) {
+            std::fill(acc.begin(), acc.end(), 0);
+            for (int ky = 0; ky < 3; ++ky) {
+                int iy = oy * L.stride + ky - 1;
+                if (iy < 0 || iy >= L.inH) continue;
+                for (int kx = 0; kx < 3; ++kx) {
+                    int ix = ox * L.stride + kx - 1;
+                    if (ix < 0 || ix >= L.inW) continue;
+                    const int8_t* src = in + ((size_t)iy * L.inW + ix) * C;
+                    const int8_t* w = L.weights.data() + (size_t)(ky * 3 + kx) * C;
+                    for (int c = 0; c < C; ++c) acc[c] += (int32_t)src[c] * (int32_t)w[c];
+                }
+            }
+            int8_t* dst = L.output.data() + ((size_t)oy * L.outW + ox) * C;
+            for (int c = 0; c < C; ++c) dst[c] = requantize(acc[c], L.shift);
+        }
+    }
+}
+
+// Share t of numThreads of one layer, batch 1. For GEMM layers each thread
+// runs im2col, GEMM and requantization on its own rows, so the stages stay
+// cache-hot and no thread waits inside a layer.
+static void runLayerPart(ConvLayer& L, const int8_t* in, GemmRowsFn gemm, unsigned int t, unsigned int numThreads) {
+    if (L.type == DEPTHWISE_3X3) {
+        int oy0 = (int)((long)L.outH * t / numThreads);
+        int oy1 = (int)((long)L.outH * (t + 1) / numThreads);
+        depthwiseRows(L, in, oy0, oy1);
+        return;
+    }
+
+    const int m = L.outH * L.outW;
+    const int8_t* a = (L.type == CONV_3X3) ? L.im2col.data() : in;
+    GemmArgs g = { a, L.weights.data(), L.weightSums.data(), L.acc.data(), L.outC, L.k };
+
+    int r0, r1;
+    rowRange(m, t, numThreads, r0, r1);
+    if (r0 >= r1) return;
+    if (L.type == CONV_3X3) im2colRows(L, in, r0, r1);
+    gemm(g, r0, r1);
+    for (size_t idx = (size_t)r0 * L.outC; idx < (size_t)r1 * L.outC; ++idx) {
+        L.output[idx] = requantize(L.acc[idx], L.shift);
+    }
+}
+
+// MobileNet-style block at 56x56. Channel counts keep every GEMM K a multiple of 32.
+static std::vector<ConvLayer> buildConvStack() {
+    std::vector<ConvLayer> layers;
+    layers.push_back(makeLayer("conv3x3_32to64", CONV_3X3,      56, 56, 32,  64,  1, 11u));
+    layers.push_back(makeLayer("dw3x3_64",       DEPTHWISE_3X3, 56, 56, 64,  64,  1, 22u));
+    layers.push_back(makeLayer("pw_64to128",     POINTWISE,     56, 56, 64,  128, 1, 33u));
+    layers.push_back(makeLayer("dw3x3_128_s2",   DEPTHWISE_3X3, 56, 56, 128, 128, 2, 44u));
+    layers.push_back(makeLayer("pw_128to128",    POINTWISE,     28, 28, 128, 128, 1, 55u));
+    return layers;
+}
+
+// One inference. The threads are started once, outside the timed region
+// (as a persistent worker pool would be), and meet at a barrier after every
+// layer; thread 0 timestamps each barrier, giving per-layer latency.
+static void runConvStack(std::vector<ConvLayer>& layers, const std::vector<int8_t>& input,
+                         GemmRowsFn gemm, unsigned int numThreads, std::vector<double>* layerMs) {
+    std::vector<std::chrono::steady_clock::time_point> stamps(layers.size() + 1);
+    SpinBarrier barrier(numThreads);
+
+    parallelFor(numThreads, [&](unsigned int t) {
+        barrier.wait();
+        if (t == 0) stamps[0] = std::chrono::steady_clock::now();
+        const int8_t* in = input.data();
+        for (size_t l = 0; l < layers.size(); ++l) {
+            runLayerPart(layers[l], in, gemm, t, numThreads);
+            barrier.wait();
+            if (t == 0) stamps[l + 1] = std::chrono::steady_clock::now();
+            in = layers[l].output.data();
+        }
+    });
+
+    if (layerMs) {
+        for (size_t l = 0; l < layers.size(); ++l) {
+            (*layerMs)[l] = std::chrono::duration<double, std::milli>(stamps[l + 1] - stamps[l]).count();
+        }
+    }
+}
+
+// =========================================================
+// SUITE
+// =========================================================
+
+InferenceBenchmark::InferenceBenchmark(const BenchmarkSizes& sizes)
+        : gemmSize(sizes.gemmSize), inferenceRepeats(sizes.inferenceRepeats) {}
+
+InferenceBenchmark::InferenceScores InferenceBenchmark::runInferenceSuite() {
+    LOGD("--- STARTING INT8 INFERENCE BENCHMARK ---");
+
+    InferenceScores scores;
+    scores.verified = true;
+    GemmRowsFn gemm = selectGemmKernel(scores.kernelPath);
+    unsigned int numCores = CpuInfo::coreCount();
+    LOGD("GEMM kernel: %s", scores.kernelPath.c_str());
+
+    // ---- Square GEMM ----
+    const int S = gemmSize;
+    uint32_t seed = 12345u;
+    std::vector<int8_t> a((size_t)S * S), bt((size_t)S * S);
+    for (auto& v : a) v = randomInt8(seed, -64, 64);
+    for (auto& v : bt) v = randomInt8(seed, -16, 16);
+    std::vector<int32_t> bSums(S, 0);
+    for (int j = 0; j < S; ++j) {
+        for (int kk = 0; kk < S; ++kk) bSums[j] += bt[(size_t)j * S + kk];
+    }
+    std::vector<int32_t> c((size_t)S * S), cRef((size_t)S * S);
+
+    GemmArgs g = { a.data(), bt.data(), bSums.data(), c.data(), S, S };
+    GemmArgs gRef = { a.data(), bt.data(), bSums.data(), cRef.data(), S, S };
+    gemmScalar(gRef, 0, S);
+
+    double gemmOps = 2.0 * S * S * S;
+    double bestSingle = 0.0, bestMulti = 0.0;
+    for (int rep = 0; rep < inferenceRepeats; ++rep) {
+        double s1 = timeSeconds([&]() { gemm(g, 0, S); });
+        if (rep == 0 || s1 < bestSingle) bestSingle = s1;
+        double sN = timeSeconds([&]() { forEachRowRange(S, numCores, [&](int r0, int r1) { gemm(g, r0, r1); }); });
+        if (rep == 0 || sN < bestMulti) bestMulti = sN;
+    }
+    if (c != cRef) scores.verified = false;
+    scores.gemmSingleGops = gemmOps / 1e9 / std::max(bestSingle, 1e-9);
+    scores.gemmMultiGops = gemmOps / 1e9 / std::max(bestMulti, 1e-9);
+    LOGD("GEMM %dx%dx%d: %.2f / %.2f GOPS", S, S, S, scores.gemmSingleGops, scores.gemmMultiGops);
+
+    // ---- Conv stack ----
+    std::vector<ConvLayer> layers = buildConvStack();
+    std::vector<int8_t> input((size_t)layers[0].inH * layers[0].inW * layers[0].inC);
+    for (auto& v : input) v = randomInt8(seed, -64, 64);
+
+    // Reference output through the scalar GEMM for bit-exact verification.
+    runConvStack(layers, input, gemmScalar, 1, nullptr);
+    std::vector<int8_t> refOutput = layers.back().output;
+
+    std::vector<double> bestLayerSingle(layers.size(), 0.0), bestLayerMulti(layers.size(), 0.0);
+    std::vector<double> layerMs(layers.size());
+    scores.stackSingleMs = 0.0;
+    scores.stackMultiMs = 0.0;
+    for (int rep = 0; rep < inferenceRepeats; ++rep) {
+        runConvStack(layers, input, gemm, 1, &layerMs);
+        double total = 0.0;
+        for (size_t l = 0; l < layers.size(); ++l) {
+            if (rep == 0 || layerMs[l] < bestLayerSingle[l]) bestLayerSingle[l] = layerMs[l];
+            total += layerMs[l];
+        }
+        if (rep == 0 || total < scores.stackSingleMs) scores.stackSingleMs = total;
+        if (layers.back().output != refOutput) scores.verified = false;
+
+        runConvStack(layers, input, gemm, numCores, &layerMs);
+        total = 0.0;
+        for (size_t l = 0; l < layers.size(); ++l) {
+            if (rep == 0 || layerMs[l] < bestLayerMulti[l]) bestLayerMulti[l] = layerMs[l];
+            total += layerMs[l];
+        }
+        if (rep == 0 || total < scores.stackMultiMs) scores.stackMultiMs = total;
+        if (layers.back().output != refOutput) scores.verified = false;
+    }
+
+    double stackOps = 0.0;
+    for (size_t l = 0; l < layers.size(); ++l) {
+        stackOps += layers[l].ops();
+        const char* path = (layers[l].type == DEPTHWISE_3X3) ? "scalar" : scores.kernelPath.c_str();
+        scores.layers.push_back({layers[l].name, path, layers[l].ops() / 1e6, bestLayerSingle[l], bestLayerMulti[l]});
+        LOGD("%s: %.1f MOPS, %.3f / %.3f ms", layers[l].name, layers[l].ops() / 1e6,
+             bestLayerSingle[l], bestLayerMulti[l]);
+    }
+    scores.stackSingleGops = stackOps / 1e6 / std::max(scores.stackSingleMs, 1e-6);
+    scores.stackMultiGops = stackOps / 1e6 / std::max(scores.stackMultiMs, 1e-6);
+    LOGD("Conv stack: %.3f / %.3f ms, %.2f / %.2f GOPS", scores.stackSingleMs, scores.stackMultiMs,
+         scores.stackSingleGops, scores.stackMultiGops);
+
+    if (!scores.verified) LOGE("Inference verification FAILED (%s)", scores.kernelPath.c_str());
+    return scores;
+}
+
+size_t InferenceBenchmark::workingSetBytes() const {
+    // int8 A and B^T plus int32 C and its scalar reference.
+    return (size_t)gemmSize * gemmSize * (2 * sizeof(int8_t) + 2 * sizeof(int32_t));
+}
+
+// =========================================================
+// REGISTRATION
+// =========================================================
+
+// Latency of one layer of the int8 conv stack.
+static std::string layerResultToJson(const InferenceBenchmark::LayerResult& l) {
+    std::stringstream ss;
+    ss << "{";
+    ss << "\"name\":\"" << l.name << "\", ";
+    ss << "\"path\":\"" << l.path << "\", ";
+    ss << "\"mops\":" << l.mops << ", ";
+        ss << "\"singleCoreMs\":" << l.singleCoreMs << ", ";
+    ss << "\"multiCoreMs\":" << l.multiCoreMs;
+    ss << "}";
+    return ss.str();
+}
+
+class InferenceKernel : public BenchmarkKernel {
+public:
+    void setup(const BenchmarkSizes& sizes) override {
+        ml.reset(new InferenceBenchmark(sizes));
+        workingSet = ml->workingSetBytes();
+    }
+    void run() override { scores = ml->runInferenceSuite(); }
+    bool verify() override { return scores.verified; }
+    void teardown() override { ml.reset(); }
+    double score() const override { return scores.gemmMultiGops; }
+    size_t workingSetBytes() const override { return workingSet; }
+    static size_t workingSetHint(const BenchmarkSizes& sizes) { return InferenceBenchmark(sizes).workingSetBytes(); }
+    void writeJson(std::ostream& out) const override {
+        out << "\"inference\":{";
+        out << "\"kernelPath\":\"" << scores.kernelPath << "\", ";
+        out << "\"verified\":" << (scores.verified ? "true" : "false") << ", ";
+        out << "\"gemmSingleGops\":" << scores.gemmSingleGops << ", ";
+        out << "\"gemmMultiGops\":" << scores.gemmMultiGops << ", ";
+        out << "\"stackSingleMs\":" << scores.stackSingleMs << ", ";
+        out << "\"stackMultiMs\":" << scores.stackMultiMs << ", ";
+        out << "\"stackSingleGops\":" << scores.stackSingleGops << ", ";
+        out << "\"stackMultiGops\":" << scores.stackMultiGops << ", ";
+        out << "\"layers\":" << jsonArray(scores.layers, layerResultToJson);
+        out << "}";
+    }
+
+private:
+    std::unique_ptr<InferenceBenchmark> ml;
+    InferenceBenchmark::InferenceScores scores = {};
+    size_t workingSet = 0;
+};
+
+static KernelRegistration<InferenceKernel> registration(
+        "inference", "ml", {"single_core", "multi_core", "int8", "simd"}, 0, 0.0, 60);
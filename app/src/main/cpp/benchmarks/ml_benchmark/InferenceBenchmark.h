@@ -0,0 +1,51 @@
+//
+// Created by Marius on 18/10/2026.
+//
+
+#ifndef PERFORMIC_INFERENCEBENCHMARK_H
+#define PERFORMIC_INFERENCEBENCHMARK_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "BenchmarkSizes.h"
+
+// Quantized (int8 x int8 -> int32) inference workload, batch 1.
+// A square GEMM plus a small MobileNet-style conv / depthwise / pointwise
+// stack. GEMM-shaped layers dispatch at runtime to I8MM, SDOT or AVX-VNNI
+// and fall back to a portable scalar kernel; depthwise layers are always
+// scalar C++.
+class InferenceBenchmark {
+public:
+    struct LayerResult {
+        std::string name;
+        std::string path;      // GEMM kernel path, "scalar" for depthwise layers
+        double mops;           // million int ops per inference (2 per MAC)
+        double singleCoreMs;
+        double multiCoreMs;
+    };
+
+    struct InferenceScores {
+        std::string kernelPath;  // "i8mm", "sdot", "avxvnni" or "scalar"
+        double gemmSingleGops;
+        double gemmMultiGops;
+        double stackSingleMs;    // whole conv stack latency
+        double stackMultiMs;
+        double stackSingleGops;
+        double stackMultiGops;
+        std::vector<LayerResult> layers;
+        bool verified;           // SIMD path bit-exact against the scalar reference
+    };
+
+    explicit InferenceBenchmark(const BenchmarkSizes& sizes);
+
+    InferenceScores runInferenceSuite();
+
+    size_t workingSetBytes() const;
+
+private:
+    int gemmSize;          // multiple of 64
+    int inferenceRepeats;
+};
+
+#endif //PERFORMIC_INFERENCEBENCHMARK_H
@@ -1,22 +1,129 @@
 #include <jni.h>
 #include <string>
+#include <cmath>
 #include <android/native_window_jni.h>
 #include "BenchmarkCore.h"
+#include "PowerSampler.h"
 #include "gpu_benchmark/GpuBenchmark.h"
 
+static std::string toStdString(JNIEnv* env, jstring text) {
+    if (text == nullptr) return "";
+    const char* chars = env->GetStringUTFChars(text, nullptr);
+    std::string result = chars ? chars : "";
+    if (chars) env->ReleaseStringUTFChars(text, chars);
+    return result;
+}
+
+// Battery power from android.os.BatteryManager, for devices where apps
+// cannot read /sys/class/power_supply. Calls back into
+// BenchmarkManager.readBatteryWatts() / isBatteryCharging(); the sampler
+// thread is not a Java thread, so it attaches to the VM around each call.
+class BatteryManagerPowerSource : public PowerSource {
+public:
+    BatteryManagerPowerSource(JNIEnv* env, jobject manager) {
+        env->GetJavaVM(&vm);
+        target = env->NewGlobalRef(manager);
+        jclass cls = env->GetObjectClass(manager);
+        readWattsMethod = env->GetMethodID(cls, "readBatteryWatts", "()D");
+        chargingMethod = env->GetMethodID(cls, "isBatteryCharging", "()Z");
+        env->DeleteLocalRef(cls);
+    }
+
+    ~BatteryManagerPowerSource() override {
+        JNIEnv* env = nullptr;
+        bool attached = false;
+        if (attach(env, attached)) {
+            env->DeleteGlobalRef(target);
+            if (attached) vm->DetachCurrentThread();
+        }
+    }
+
+    bool readWatts(double& watts) override {
+        JNIEnv* env = nullptr;
+        bool attached = false;
+        if (readWattsMethod == nullptr || !attach(env, attached)) return false;
+        double value = env->CallDoubleMethod(target, readWattsMethod);
+        bool ok = !env->ExceptionCheck() && std::isfinite(value) && value > 0.0;
+        env->ExceptionClear();
+        if (attached) vm->DetachCurrentThread();
+        if (ok) watts = value;
+        return ok;
+    }
+
+    bool isCharging() override {
+        JNIEnv* env = nullptr;
+        bool attached = false;
+        if (chargingMethod == nullptr || !attach(env, attached)) return false;
+        bool charging = env->CallBooleanMethod(target, chargingMethod) == JNI_TRUE;
+        if (env->ExceptionCheck()) {
+            env->ExceptionClear();
+            charging = false;
+        }
+        if (attached) vm->DetachCurrentThread();
+        return charging;
+    }
+
+    std::string describe() const override { return "BatteryManager"; }
+
+private:
+    JavaVM* vm = nullptr;
+    jobject target = nullptr;
+    jmethodID readWattsMethod = nullptr;
+    jmethodID chargingMethod = nullptr;
+
+    // attached is true when this call attached the thread and must detach it.
+    bool attach(JNIEnv*& env, bool& attached) {
+        jint status = vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6);
+        if (status == JNI_OK) return true;
+        if (status != JNI_EDETACHED || vm->AttachCurrentThread(&env, nullptr) != JNI_OK) return false;
+        attached = true;
+        return true;
+    }
+};
+
+static void useBatteryManagerFallback(BenchmarkCore& core, JNIEnv* env, jobject manager) {
+    core.setFallbackPowerSource(std::unique_ptr<PowerSource>(new BatteryManagerPowerSource(env, manager)));
+}
+
 extern "C" JNIEXPORT jstring JNICALL
 Java_com_example_performic_BenchmarkManager_runNativeBenchmark(
         JNIEnv* env,
-        jobject /* this */) {
+        jobject thiz /* this */) {
 
     BenchmarkCore core;
+    useBatteryManagerFallback(core, env, thiz);
 
     std::string json_result = core.runFullBenchmark();
 
     return env->NewStringUTF(json_result.c_str());
 }
 
-extern "C" JNIEXPORT jdouble JNICALL
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_example_performic_BenchmarkManager_runNativeBenchmarkSubset(
+        JNIEnv* env,
+        jobject thiz /* this */,
+        jstring filter,   // e.g. "cpu_single,memory" or "simd"
+        jstring preset) { // "quick", "standard" or "extended"
+
+    BenchmarkCore core;
+    useBatteryManagerFallback(core, env, thiz);
+
+    std::string json_result = core.runBenchmarks(toStdString(env, filter), toStdString(env, preset));
+
+    return env->NewStringUTF(json_result.c_str());
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_example_performic_BenchmarkManager_listNativeBenchmarks(
+        JNIEnv* env,
+        jobject /* this */) {
+
+    BenchmarkCore core;
+    return env->NewStringUTF(core.listBenchmarks().c_str());
+}
+
+// JSON: {"success", "name", "score", "energy"}, energy as in the core report.
+extern "C" JNIEXPORT jstring JNICALL
 Java_com_example_performic_BenchmarkManager_runGpuBenchmark(
         JNIEnv* env,
         jobject thiz /* this */,
@@ -24,9 +131,13 @@ Java_com_example_performic_BenchmarkManager_runGpuBenchmark(
 
     ANativeWindow* window = ANativeWindow_fromSurface(env, surface);
 
-    GpuBenchmark gpu;
-    double score = gpu.run(window, env, thiz);
+    BenchmarkCore core;
+    useBatteryManagerFallback(core, env, thiz);
+    std::string json_result = core.runMeasured("gpu", [&]() {
+        GpuBenchmark gpu;
+        return gpu.run(window, env, thiz);
+    });
 
     ANativeWindow_release(window);
-    return score;
+    return env->NewStringUTF(json_result.c_str());
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "BenchmarkCore.h"
+
+// Runs registered kernels outside the app and prints the JSON report.
+//   performic_cli --list                     (working sets at the chosen preset)
+//   performic_cli --run <names|suites|tags>   (comma separated, default: all)
+//   performic_cli --preset quick              (quick | standard | extended)
+static void printUsage(const char* argv0) {
+    fprintf(stderr, "usage: %s [--list] [--run <filter>] [--preset quick|standard|extended]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string preset = "standard";
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else if (strcmp(argv[i], "--run") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--preset") == 0 && i + 1 < argc) {
+            preset = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    BenchmarkCore core;
+    if (list) {
+        printf("%s\n", core.listBenchmarks(preset).c_str());
+        return 0;
+    }
+
+    std::string json = core.runBenchmarks(filter, preset);
+    printf("%s\n", json.c_str());
+    // Non-zero when nothing matched or any kernel failed verification, so
+    // scripts can gate on the exit status alone.
+    bool ok = json.compare(0, 15, "{\"success\":true") == 0 &&
+              json.find("\"verified\":false") == std::string::npos;
+    return ok ? 0 : 1;
+}
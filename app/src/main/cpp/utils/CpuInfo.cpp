@@ -0,0 +1,160 @@
+#include "CpuInfo.h"
+#include <thread>
+#include <fstream>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <unistd.h>
+
+#if defined(__aarch64__)
+#include <sys/auxv.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+// Bit positions from the kernel's uapi <asm/hwcap.h>, spelled out so the
+// file also builds against headers that predate them.
+#if defined(__aarch64__)
+static constexpr unsigned long ARM_HWCAP_AES     = 1UL << 3;
+static constexpr unsigned long ARM_HWCAP_PMULL   = 1UL << 4;
+static constexpr unsigned long ARM_HWCAP_SHA2    = 1UL << 6;
+static constexpr unsigned long ARM_HWCAP_CRC32   = 1UL << 7;
+static constexpr unsigned long ARM_HWCAP_ASIMDHP = 1UL << 10;
+static constexpr unsigned long ARM_HWCAP_ASIMDDP = 1UL << 20;
+static constexpr unsigned long ARM_HWCAP2_I8MM    = 1UL << 13;
+#endif
+
+static CpuInfo::Features detectFeatures() {
+    CpuInfo::Features f;
+
+#if defined(__aarch64__)
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    f.asimdhp = (hwcap & ARM_HWCAP_ASIMDHP) != 0;
+    f.dotprod = (hwcap & ARM_HWCAP_ASIMDDP) != 0;
+    f.aes = (hwcap & ARM_HWCAP_AES) != 0;
+    f.pmull = (hwcap & ARM_HWCAP_PMULL) != 0;
+    f.sha2 = (hwcap & ARM_HWCAP_SHA2) != 0;
+    f.crc32 = (hwcap & ARM_HWCAP_CRC32) != 0;
+    unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    f.i8mm = (hwcap2 & ARM_HWCAP2_I8MM) != 0;
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        // SSE-encoded extensions need no OS opt-in beyond SSE itself.
+        bool sse41 = (ecx & (1u << 19)) != 0;
+        f.sse42 = (ecx & (1u << 20)) != 0;
+        f.pclmul = (ecx & (1u << 1)) != 0;
+        f.aesni = sse41 && (ecx & (1u << 25)) != 0;
+
+        // AVX state must be enabled by the OS (XCR0) before any VEX path is usable.
+        bool osxsave = (ecx & (1u << 27)) != 0;
+        bool avx = (ecx & (1u << 28)) != 0;
+        bool ymmEnabled = false;
+        if (osxsave && avx) {
+            unsigned int xcr0Lo, xcr0Hi;
+            asm volatile("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+            ymmEnabled = (xcr0Lo & 0x6) == 0x6;
+        }
+        f.fma = ymmEnabled && (ecx & (1u << 12)) != 0;
+
+        if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            f.shani = sse41 && (ebx & (1u << 29)) != 0;
+            if (ymmEnabled) {
+                f.avx2 = (ebx & (1u << 5)) != 0;
+                unsigned int eax1 = 0, ebx1 = 0, ecx1 = 0, edx1 = 0;
+                __get_cpuid_count(7, 1, &eax1, &ebx1, &ecx1, &edx1);
+                f.avxvnni = f.avx2 && (eax1 & (1u << 4)) != 0;
+            }
+        }
+    }
+#endif
+
+    return f;
+}
+
+const CpuInfo::Features& CpuInfo::features() {
+    static const Features cached = detectFeatures();
+    return cached;
+}
+
+// "48K", "1024K", "8M" or a plain byte count.
+static size_t parseCacheSize(const std::string& text) {
+    size_t value = 0;
+    size_t i = 0;
+    while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+        value = value * 10 + (size_t)(text[i] - '0');
+        ++i;
+    }
+    if (i < text.size() && (text[i] == 'K' || text[i] == 'k')) value *= 1024;
+    if (i < text.size() && (text[i] == 'M' || text[i] == 'm')) value *= 1024 * 1024;
+    return value;
+}
+
+static CpuInfo::Caches detectCaches() {
+    size_t levels[4] = {0, 0, 0, 0};
+
+    for (unsigned int cpu = 0; cpu < CpuInfo::coreCount(); ++cpu) {
+        std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache/index";
+        for (int index = 0; index < 8; ++index) {
+            std::string dir = base + std::to_string(index);
+            std::ifstream levelIn(dir + "/level"), typeIn(dir + "/type"), sizeIn(dir + "/size");
+            int level = 0;
+            std::string type, size;
+            if (!(levelIn >> level) || !(typeIn >> type) || !(sizeIn >> size)) break;
+            if (type == "Instruction" || level < 1 || level > 3) continue;
+            levels[level] = std::max(levels[level], parseCacheSize(size));
+        }
+    }
+
+    CpuInfo::Caches c;
+    c.detected = levels[1] != 0 || levels[2] != 0;
+    c.l1dBytes = levels[1] ? levels[1] : 32 * 1024;
+    c.l2Bytes = levels[2] ? levels[2] : 512 * 1024;
+    c.llcBytes = std::max(levels[3], c.l2Bytes);
+    return c;
+}
+
+const CpuInfo::Caches& CpuInfo::caches() {
+    static const Caches cached = detectCaches();
+    return cached;
+}
+
+size_t CpuInfo::totalRamBytes() {
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages <= 0 || pageSize <= 0) return 0;
+    uint64_t bytes = (uint64_t)pages * (uint64_t)pageSize;
+    return (size_t)std::min<uint64_t>(bytes, SIZE_MAX); // 32-bit ABIs on large-RAM devices
+}
+
+unsigned int CpuInfo::coreCount() {
+    unsigned int numCores = std::thread::hardware_concurrency();
+    if (numCores == 0) numCores = 4;
+    return numCores;
+}
+
+std::vector<double> CpuInfo::coreMaxFrequenciesGHz() {
+    std::vector<double> freqs;
+    unsigned int numCores = coreCount();
+    freqs.reserve(numCores);
+
+    for (unsigned int cpu = 0; cpu < numCores; ++cpu) {
+        std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                           "/cpufreq/cpuinfo_max_freq";
+        std::ifstream in(path);
+        long khz = 0;
+        if (!(in >> khz)) khz = 0;
+        freqs.push_back((double)khz / 1e6);
+    }
+    return freqs;
+}
+
+double CpuInfo::maxFrequencyGHz() {
+    std::vector<double> freqs = coreMaxFrequenciesGHz();
+    if (freqs.empty()) return 0.0;
+    return *std::max_element(freqs.begin(), freqs.end());
+}
@@ -0,0 +1,62 @@
+//
+// Created by Marius on 18/10/2026.
+//
+
+#ifndef PERFORMIC_CPUINFO_H
+#define PERFORMIC_CPUINFO_H
+
+#include <stddef.h>
+#include <vector>
+
+// Runtime hardware detection shared by the native suites.
+// Kernels that have an ISA-specific fast path ask here before dispatching,
+// so a single arm64-v8a / x86_64 build runs the best path the device supports.
+class CpuInfo {
+public:
+    struct Features {
+        // ARM (HWCAP / HWCAP2)
+        bool asimdhp = false;  // ARMv8.2 half-precision vector arithmetic
+        bool dotprod = false;  // SDOT / UDOT
+        bool i8mm = false;     // SMMLA / UMMLA / USDOT
+        bool aes = false;      // AESE / AESMC
+        bool pmull = false;    // 64x64 -> 128 polynomial multiply
+        bool sha2 = false;     // SHA256H / SHA256SU0 / ...
+        bool crc32 = false;    // CRC32 / CRC32C
+
+        // x86 (CPUID)
+        bool avx2 = false;
+        bool fma = false;      // FMA3 (VEX-encoded, needs the OS AVX state)
+        bool avxvnni = false;  // VEX-encoded VPDPBUSD (AVX-VNNI)
+        bool aesni = false;    // AES-NI (with SSE4.1)
+        bool pclmul = false;   // PCLMULQDQ
+        bool shani = false;    // SHA extensions (with SSE4.1)
+        bool sse42 = false;    // CRC32 instruction (CRC32C polynomial)
+    };
+
+    // Largest data/unified cache of each level over all CPUs, so a big core
+    // on a heterogeneous SoC sets the size. Levels not exposed in sysfs fall
+    // back to conservative defaults (32 KB L1d, 512 KB L2, LLC = L2).
+    struct Caches {
+        size_t l1dBytes;
+        size_t l2Bytes;
+        size_t llcBytes;   // L3 / system cache when present, else L2
+        bool detected;     // false when every value is a default
+    };
+
+    static const Features& features();
+    static const Caches& caches();
+
+    // Physical RAM in bytes, 0 when unknown.
+    static size_t totalRamBytes();
+
+    // Number of CPUs the scheduler can use (never 0).
+    static unsigned int coreCount();
+
+    // cpuinfo_max_freq of every CPU in GHz, 0.0 where cpufreq is not exposed.
+    static std::vector<double> coreMaxFrequenciesGHz();
+
+    // Highest per-core max frequency, 0.0 when unknown.
+    static double maxFrequencyGHz();
+};
+
+#endif //PERFORMIC_CPUINFO_H
@@ -0,0 +1,148 @@
+#include "PowerSampler.h"
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+#include <dirent.h>
+
+static bool readFirstLine(const std::string& path, std::string& out) {
+    std::ifstream in(path);
+    return (bool)std::getline(in, out);
+}
+
+static bool readLong(const std::string& path, long long& out) {
+    std::ifstream in(path);
+    return (bool)(in >> out);
+}
+
+// =========================================================
+// SYSFS SOURCE
+// =========================================================
+
+SysfsPowerSource::SysfsPowerSource(const std::string& root) {
+    DIR* dir = opendir(root.c_str());
+    if (dir == nullptr) return;
+
+    std::vector<std::string> names;
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') names.push_back(entry->d_name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end()); // deterministic pick when several batteries exist
+
+    for (const std::string& name : names) {
+        std::string candidate = root + "/" + name;
+        std::string type;
+        long long value = 0;
+        if (readFirstLine(candidate + "/type", type) && type == "Battery" &&
+            readLong(candidate + "/current_now", value) &&
+            readLong(candidate + "/voltage_now", value)) {
+            supplyDir = candidate;
+            return;
+        }
+    }
+}
+
+bool SysfsPowerSource::readWatts(double& watts) {
+    if (supplyDir.empty()) return false;
+    long long microAmps = 0, microVolts = 0;
+    if (!readLong(supplyDir + "/current_now", microAmps)) return false;
+    if (!readLong(supplyDir + "/voltage_now", microVolts)) return false;
+    if (microVolts <= 0) return false;
+    // Vendors disagree on the sign of a discharging current.
+    watts = std::fabs((double)microAmps) * 1e-6 * (double)microVolts * 1e-6;
+    return true;
+}
+
+bool SysfsPowerSource::isCharging() {
+    std::string status;
+    return !supplyDir.empty() && readFirstLine(supplyDir + "/status", status) && status == "Charging";
+}
+
+// =========================================================
+// SAMPLER
+// =========================================================
+
+PowerSampler::PowerSampler(std::unique_ptr<PowerSource> powerSource) : source(std::move(powerSource)) {
+    double watts = 0.0;
+    isAvailable = source && source->readWatts(watts);
+    if (!isAvailable) return;
+
+    wasCharging = source->isCharging();
+    lastWatts = watts;
+    lastSample = std::chrono::steady_clock::now();
+    sampler = std::thread(&PowerSampler::samplerLoop, this);
+}
+
+PowerSampler::~PowerSampler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wake.notify_all();
+    if (sampler.joinable()) sampler.join();
+}
+
+// Trapezoidal integration since the previous sample. A failed read holds
+// the previous power value instead of dropping the interval.
+void PowerSampler::sampleLocked() {
+    auto now = std::chrono::steady_clock::now();
+    double watts = lastWatts;
+    if (!source->readWatts(watts)) watts = lastWatts;
+    double dt = std::chrono::duration<double>(now - lastSample).count();
+    totalJoules += 0.5 * (lastWatts + watts) * dt;
+    lastWatts = watts;
+    lastSample = now;
+}
+
+void PowerSampler::samplerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopRequested) {
+        sampleLocked();
+        wake.wait_for(lock, std::chrono::milliseconds(SAMPLE_INTERVAL_MS), [this]() { return stopRequested; });
+    }
+}
+
+double PowerSampler::snapshotJoules() {
+    if (!isAvailable) return 0.0;
+    std::lock_guard<std::mutex> lock(mutex);
+    sampleLocked();
+    return totalJoules;
+}
+
+void PowerSampler::measureIdleBaseline(int durationMs) {
+    if (!isAvailable) return;
+    double j0 = snapshotJoules();
+    auto t0 = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+    double j1 = snapshotJoules();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    baselineWatts = (sec > 0.0) ? (j1 - j0) / sec : 0.0;
+}
+
+void PowerSampler::beginWindow(const std::string& name) {
+    windowName = name;
+    windowStartJoules = snapshotJoules();
+    windowStart = std::chrono::steady_clock::now();
+}
+
+void PowerSampler::endWindow(double score, int iterations) {
+    if (!isAvailable) return;
+    double joules = snapshotJoules() - windowStartJoules;
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - windowStart).count();
+    if (source->isCharging()) wasCharging = true;
+
+    EnergyResult r;
+    r.name = windowName;
+    r.seconds = sec;
+    r.joules = joules;
+    r.netJoules = std::max(0.0, joules - baselineWatts * sec);
+    r.averageWatts = (sec > 0.0) ? joules / sec : 0.0;
+    // Both efficiency numbers use power above idle, so a core that idles
+    // low is not charged for the rest of the SoC.
+    r.netAverageWatts = std::max(0.0, r.averageWatts - baselineWatts);
+    r.iterations = std::max(0, iterations);
+    r.joulesPerIteration = (r.iterations > 0) ? r.netJoules / r.iterations : 0.0;
+    r.score = score;
+    r.scorePerWatt = (r.netAverageWatts > 0.0) ? score / r.netAverageWatts : 0.0;
+    windows.push_back(r);
+}
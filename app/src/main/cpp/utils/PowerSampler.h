@@ -0,0 +1,105 @@
+//
+// Created by Marius on 18/10/2026.
+//
+
+#ifndef PERFORMIC_POWERSAMPLER_H
+#define PERFORMIC_POWERSAMPLER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+
+// Where instantaneous battery power comes from. The sysfs reader below is
+// the native default; the app falls back to BatteryManager through JNI
+// (native-lib.cpp) when sysfs is not readable.
+class PowerSource {
+public:
+    virtual ~PowerSource() {}
+    virtual bool readWatts(double& watts) = 0;
+    virtual bool isCharging() { return false; }
+    virtual std::string describe() const = 0;
+};
+
+// Reads current_now (uA) and voltage_now (uV) of the first "Battery" supply
+// under root. root is configurable so a fake tree can stand in on Linux.
+class SysfsPowerSource : public PowerSource {
+public:
+    static constexpr const char* DEFAULT_ROOT = "/sys/class/power_supply";
+
+    explicit SysfsPowerSource(const std::string& root = DEFAULT_ROOT);
+
+    bool readWatts(double& watts) override;
+    bool isCharging() override;
+    std::string describe() const override { return supplyDir; }
+
+private:
+    std::string supplyDir;  // empty when no usable battery was found
+};
+
+// Integrates power on a background thread and slices the running energy
+// total into named windows, one per subtest.
+class PowerSampler {
+public:
+    struct EnergyResult {
+        std::string name;
+        double seconds;
+        double joules;              // integrated battery power over the window
+        double netJoules;           // joules minus idle baseline * seconds (>= 0)
+        double averageWatts;        // joules / seconds
+        double netAverageWatts;     // averageWatts minus idle baseline (>= 0)
+        int iterations;             // 0 when the kernel has no meaningful unit of work
+        double joulesPerIteration;  // netJoules / iterations, 0 when iterations is 0
+        double score;               // the subtest's headline number
+        double scorePerWatt;        // score / netAverageWatts
+    };
+
+    explicit PowerSampler(std::unique_ptr<PowerSource> source);
+    ~PowerSampler();
+
+    bool available() const { return isAvailable; }
+    bool charging() const { return wasCharging; }
+    std::string sourceName() const { return source->describe(); }
+
+    // Sleeps for durationMs while sampling; later windows subtract this power.
+    void measureIdleBaseline(int durationMs);
+    double idleWatts() const { return baselineWatts; }
+
+    // Windows are only recorded while a power source is available.
+    void beginWindow(const std::string& name);
+    void endWindow(double score, int iterations);
+
+    const std::vector<EnergyResult>& results() const { return windows; }
+
+private:
+    static constexpr int SAMPLE_INTERVAL_MS = 100;
+
+    std::unique_ptr<PowerSource> source;
+    bool isAvailable = false;
+    bool wasCharging = false;
+    double baselineWatts = 0.0;
+
+    // Guarded by mutex
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopRequested = false;
+    double totalJoules = 0.0;
+    double lastWatts = 0.0;
+    std::chrono::steady_clock::time_point lastSample;
+
+    std::thread sampler;
+
+    std::string windowName;
+    double windowStartJoules = 0.0;
+    std::chrono::steady_clock::time_point windowStart;
+    std::vector<EnergyResult> windows;
+
+    void sampleLocked();
+    void samplerLoop();
+    double snapshotJoules();
+};
+
+#endif //PERFORMIC_POWERSAMPLER_H
@@ -5,6 +5,12 @@
 #ifndef PERFORMIC_UTILS_H
 #define PERFORMIC_UTILS_H
 
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
 inline void ClobberMemory() {
     asm volatile("" ::: "memory");
 }
@@ -14,4 +20,63 @@ inline void DoNotOptimize(T const& value) {
     asm volatile("" : : "r,m"(value) : "memory");
 }
 
+// Runs fn(t) on numThreads threads (t = 0..numThreads-1) and waits for all of them.
+template <typename Fn>
+inline void parallelFor(unsigned int numThreads, Fn fn) {
+    if (numThreads <= 1) {
+        fn(0u);
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        threads.emplace_back(fn, t);
+    }
+    for (auto& th : threads) { if (th.joinable()) th.join(); }
+}
+
+// Reusable barrier for threads that meet many times in quick succession
+// (e.g. between layers). Waiters spin, yielding, instead of sleeping.
+class SpinBarrier {
+public:
+    explicit SpinBarrier(unsigned int count) : count(count), waiting(0), generation(0) {}
+
+    void wait() {
+        unsigned int gen = generation.load(std::memory_order_acquire);
+        if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            waiting.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+        while (generation.load(std::memory_order_acquire) == gen) std::this_thread::yield();
+    }
+
+private:
+    const unsigned int count;
+    std::atomic<unsigned int> waiting;
+    std::atomic<unsigned int> generation;
+};
+
+// "[...]" with toJson(item) for each item, comma separated.
+template <typename T, typename Fn>
+inline std::string jsonArray(const std::vector<T>& items, Fn toJson) {
+    std::string out = "[";
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (i > 0) out += ",";
+        out += toJson(items[i]);
+    }
+    return out + "]";
+}
+
+// Wall time of fn() in seconds.
+template <typename Fn>
+inline double timeSeconds(Fn fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    ClobberMemory();
+    fn();
+    ClobberMemory();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
 #endif //PERFORMIC_UTILS_H
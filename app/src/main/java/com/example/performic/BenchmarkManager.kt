@@ -24,7 +24,14 @@ class BenchmarkManager(private val context: Context) {
 
     // C++ returns a JSON string containing the scores AND the real history arrays
     private external fun runNativeBenchmark(): String
-    private external fun runGpuBenchmark(surface: android.view.Surface): Double
+    // Subset by comma separated kernel names, suites or tags, e.g. "cpu_single,memory".
+    // preset: "quick", "standard" or "extended"
+    private external fun runNativeBenchmarkSubset(filter: String, preset: String): String
+    // JSON array of registered kernels (name, suite, tags, threads, workingSetBytes at
+    // the standard preset, referenceScore)
+    private external fun listNativeBenchmarks(): String
+    // JSON: success, name, score, energy (same energy block as the core run)
+    private external fun runGpuBenchmark(surface: android.view.Surface): String
 
     companion object {
         init {
@@ -51,11 +58,33 @@ class BenchmarkManager(private val context: Context) {
         return tempInt / 10.0f
     }
 
+    // Called from native code when /sys/class/power_supply is not readable.
+    // NaN when the device does not report battery current.
+    fun readBatteryWatts(): Double {
+        val batteryManager = context.getSystemService(Context.BATTERY_SERVICE) as BatteryManager
+        val microAmps = batteryManager.getLongProperty(BatteryManager.BATTERY_PROPERTY_CURRENT_NOW)
+        if (microAmps == 0L || microAmps == Long.MIN_VALUE) return Double.NaN
+        val intent = context.registerReceiver(null, IntentFilter(Intent.ACTION_BATTERY_CHANGED))
+        val milliVolts = intent?.getIntExtra(BatteryManager.EXTRA_VOLTAGE, 0) ?: 0
+        if (milliVolts <= 0) return Double.NaN
+        // Vendors disagree on the sign of a discharging current.
+        return Math.abs(microAmps) * 1e-6 * milliVolts * 1e-3
+    }
+
+    // Called from native code alongside readBatteryWatts().
+    fun isBatteryCharging(): Boolean {
+        val batteryManager = context.getSystemService(Context.BATTERY_SERVICE) as BatteryManager
+        return batteryManager.isCharging
+    }
+
     // =========================================================================
     // BENCHMARK LOGIC
     // =========================================================================
 
+    // filter empty + standard preset = full run; otherwise see runNativeBenchmarkSubset
     fun runCoreBenchmarkWithMonitoring(
+        filter: String = "",
+        preset: String = "standard",
         onComplete: (BenchmarkResult, List<ThermalPoint>) -> Unit
     ) {
         val thermalHistory = Collections.synchronizedList(ArrayList<ThermalPoint>())
@@ -84,7 +113,9 @@ class BenchmarkManager(private val context: Context) {
 
             // --- CALL C++ (BLOCKING) ---
             // C++ runs the loop (20x), collects REAL data, and returns JSON
-            val jsonResultFromCpp = runNativeBenchmark()
+            val jsonResultFromCpp =
+                if (filter.isEmpty() && preset == "standard") runNativeBenchmark()
+                else runNativeBenchmarkSubset(filter, preset)
             // ---------------------------
 
             isBenchmarkRunning.set(false) // Stop monitor
@@ -112,8 +143,18 @@ class BenchmarkManager(private val context: Context) {
         benchmarkThread.start()
     }
 
-    fun runGpuTest(surface: android.view.Surface): Double {
-        return runGpuBenchmark(surface)
+    fun runGpuTest(surface: android.view.Surface): GpuResult {
+        val json = runGpuBenchmark(surface)
+        Log.d("Performic", "GPU JSON: $json")
+        return try {
+            Gson().fromJson(json, GpuResult::class.java)
+        } catch (e: Exception) {
+            GpuResult(false, "gpu", 0.0)
+        }
+    }
+
+    fun listCoreBenchmarks(): String {
+        return listNativeBenchmarks()
     }
 
     // =========================================================================
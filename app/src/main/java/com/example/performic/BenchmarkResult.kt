@@ -11,7 +11,184 @@ data class BenchmarkResult(
     val l1GBs: Double? = null, // NEW
     val l2GBs: Double? = null,
 
+    val maxFrequencyGHz: Double? = null,
+    val fpPeak: List<PeakResult> = emptyList(),
+    val dataStructures: DataStructureResult? = null,
+    val inference: InferenceResult? = null,
+    val imagePipeline: ImagePipelineResult? = null,
+    val crypto: CryptoResult? = null,
+    val energy: EnergyResult? = null,
+    val selection: String? = null,
+    val sizes: SizesResult? = null,
+    val kernels: List<KernelResult> = emptyList(),
+
     val singleCoreHistory: List<Double> = emptyList(),
     val multiCoreHistory: List<Double> = emptyList()
 )
 
+// One peak-throughput kernel (GFLOPS for fp, GOPS for integer kernels) and its theoretical ceiling.
+data class PeakResult(
+    val name: String,
+    val supported: Boolean,
+    val singleCoreGops: Double,
+    val multiCoreGops: Double,
+    val singleCorePeak: Double,
+    val multiCorePeak: Double
+)
+
+// Single-thread / all-core throughput pair, in Mkeys/s.
+data class Throughput(
+    val single: Double,
+    val multi: Double
+)
+
+data class DataStructureResult(
+    val verified: Boolean,
+    val stdSort: Double,
+    val radixSort: Throughput,
+    val sampleSort: Throughput,
+    val hashInsert: Throughput,
+    val hashLookupHit: Throughput,
+    val hashLookupMiss: Throughput,
+    val hashLookupMixed: Throughput, // 75% hits, 25% misses
+    val hashErase: Throughput
+)
+
+// path: the GEMM kernel path, or "scalar" for depthwise layers.
+data class LayerResult(
+    val name: String,
+    val path: String,
+    val mops: Double,
+    val singleCoreMs: Double,
+    val multiCoreMs: Double
+)
+
+// Int8 GEMM + conv stack at batch 1. kernelPath: "i8mm", "sdot", "avxvnni" or "scalar".
+data class InferenceResult(
+    val kernelPath: String,
+    val verified: Boolean,
+    val gemmSingleGops: Double,
+    val gemmMultiGops: Double,
+    val stackSingleMs: Double,
+    val stackMultiMs: Double,
+    val stackSingleGops: Double,
+    val stackMultiGops: Double,
+    val layers: List<LayerResult>
+)
+
+data class StageResult(
+    val name: String,
+    val simdMpixPerSec: Double,
+    val scalarMpixPerSec: Double
+)
+
+// 12 MP YUV -> RGB -> blur -> Sobel -> resize. simdPath: "neon", "sse2" or "avx2".
+data class ImagePipelineResult(
+    val simdPath: String,
+    val verified: Boolean,
+    val unfusedMpixPerSec: Double,
+    val fusedMpixPerSec: Double,
+    val fusedSingleCoreMpixPerSec: Double,
+    val stages: List<StageResult>
+)
+
+// GB/s for one message size, single thread and all cores.
+data class CryptoThroughput(
+    val singleGBs: Double,
+    val multiGBs: Double
+)
+
+// path: "aesni+pclmul", "shani", "sse4.2", "aes+pmull", "sha2", "crc32" or "scalar".
+data class CryptoAlgorithmResult(
+    val name: String,
+    val path: String,
+    val small: CryptoThroughput,
+    val large: CryptoThroughput,
+    val scalarLargeSingleGBs: Double
+)
+
+// AES-128-GCM / CTR, SHA-256, CRC32C and XXH64 over small and large messages.
+data class CryptoResult(
+    val verified: Boolean,
+    val smallBytes: Long,
+    val largeBytes: Long,
+    val algorithms: List<CryptoAlgorithmResult>
+)
+
+data class SubtestEnergy(
+    val name: String,
+    val seconds: Double,
+    val joules: Double,
+    val netJoules: Double,
+    val averageWatts: Double,
+    val netAverageWatts: Double,
+    val iterations: Int,
+    val joulesPerIteration: Double? = null,
+    val score: Double,
+    val scorePerWatt: Double
+)
+
+// Battery power integrated per subtest; netJoules, netAverageWatts and
+// scorePerWatt have the idle baseline removed. subtests is empty without a
+// power source. joulesPerIteration is absent for kernels with no unit of work.
+// Readings taken while charging are not meaningful. source is the sysfs
+// battery directory, or "BatteryManager" when sysfs was not readable.
+data class EnergyResult(
+    val available: Boolean,
+    val source: String,
+    val charging: Boolean,
+    val idleWatts: Double,
+    val subtests: List<SubtestEnergy>
+)
+
+// The GPU scene, measured in its own energy window (idle baseline included).
+data class GpuResult(
+    val success: Boolean,
+    val name: String,
+    val score: Double,
+    val energy: EnergyResult? = null
+)
+
+// One registry kernel of this run. threads == 0 means all cores;
+// relativeScore is score / referenceScore (0 when there is no reference yet).
+data class KernelResult(
+    val name: String,
+    val suite: String,
+    val tags: List<String>,
+    val threads: Int,
+    val workingSetBytes: Long,
+    val referenceScore: Double,
+    val score: Double,
+    val relativeScore: Double,
+    val verified: Boolean,
+    val seconds: Double
+)
+
+// Problem sizes chosen for this run from the detected caches / RAM.
+// singleCore / multiCore always run at the fixed calibration sizes and are
+// comparable across presets; other suites only between runs with the same sizes.
+data class SizesResult(
+    val preset: String,
+    val cachesDetected: Boolean,
+    val l1dBytes: Long,
+    val l2Bytes: Long,
+    val llcBytes: Long,
+    val ramBytes: Long,
+    val cores: Int,
+    val stabilityIterations: Int,
+    val matrixSize: Int,
+    val luMatrixSize: Int,
+    val intArraySize: Int,
+    val compressionSize: Int,
+    val mandelbrotSize: Int,
+    val mandelbrotIter: Int,
+    val memL1Bytes: Long,
+    val memL2Bytes: Long,
+    val memRamBytes: Long,
+    val peakIterations: Long,
+    val sortKeys: Int,
+    val hashKeys: Int,
+    val gemmSize: Int,
+    val cryptoSmallBytes: Long,
+    val cryptoLargeBytes: Long
+)
@@ -88,7 +88,7 @@ class MainActivity : AppCompatActivity() {
             override fun surfaceCreated(holder: SurfaceHolder) {
                 Thread {
                     try {
-                        val gpuScore = benchmarkManager.runGpuTest(holder.surface)
+                        val gpuScore = benchmarkManager.runGpuTest(holder.surface).score
                         runOnUiThread {
                             benchmarkManager.cleanupAfterBenchmark()
                             // TEST COMPLETE: Show all graphs